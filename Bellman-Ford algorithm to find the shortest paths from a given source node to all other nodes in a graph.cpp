@@ -1,90 +1,66 @@
 #include <iostream>
 #include <vector>
-#include <climits>
+#include <string>
+#include <stdexcept>
+#include "bellman_ford.h"
+#include "fast_io.h"
 using namespace std;
+using namespace bellman_ford;
+using namespace fast_io;
 
-/*
- * Structure to represent an edge of the graph.
- * Contains:
- *  - `src`: Source vertex
- *  - `dest`: Destination vertex
- *  - `weight`: Weight of the edge
- */
-struct Edge {
-    int src, dest, weight;
-};
-
-/*
- * Function to implement the Bellman-Ford algorithm.
- * Parameters:
- *  - edges: Vector of edges representing the graph
- *  - V: Number of vertices
- *  - E: Number of edges
- *  - source: The source vertex from which shortest paths are calculated
- * Prints:
- *  - Shortest distances from the source to all vertices
- *  - Reports if a negative weight cycle is detected
- */
-void bellmanFord(vector<Edge>& edges, int V, int E, int source) {
-    // Initialize distances from source to all vertices as infinite (INT_MAX)
-    vector<int> distance(V, INT_MAX);
-    distance[source] = 0;
+int main(int argc, char* argv[]) {
+    try {
+        DriverOptions options = parseDriverOptions(argc, argv);
+        FastReader in(options.input);
+        FastWriter out(!options.batch);
 
-    // Relax all edges (V-1) times
-    for (int i = 1; i <= V - 1; i++) {
-        for (const Edge& edge : edges) {
-            if (distance[edge.src] != INT_MAX && distance[edge.src] + edge.weight < distance[edge.dest]) {
-                distance[edge.dest] = distance[edge.src] + edge.weight;
-            }
+        // Input number of vertices and edges
+        out.prompt("Enter the number of vertices: ");
+        int V = in.next<int>();
+        out.prompt("Enter the number of edges: ");
+        int E = in.next<int>();
+        if (V < 1 || E < 0) {
+            throw invalid_argument("The graph needs at least one vertex and a non-negative number of edges");
         }
-    }
 
-    // Check for negative weight cycles
-    for (const Edge& edge : edges) {
-        if (distance[edge.src] != INT_MAX && distance[edge.src] + edge.weight < distance[edge.dest]) {
-            cout << "Graph contains a negative weight cycle!" << endl;
-            return;
-        }
-    }
+        vector<Edge> edges(E);
 
-    // Print the shortest distances
-    cout << "Vertex   Distance from Source" << endl;
-    for (int i = 0; i < V; i++) {
-        cout << i << "         " << (distance[i] == INT_MAX ? "INF" : to_string(distance[i])) << endl;
-    }
-}
-
-int main() {
-    // Input number of vertices and edges
-    int V, E;
-    cout << "Enter the number of vertices: ";
-    cin >> V;
-    cout << "Enter the number of edges: ";
-    cin >> E;
-
-    vector<Edge> edges(E);
+        // Input the edges
+        out.prompt("Enter the edges in the format (src dest weight):\n");
+        for (int i = 0; i < E; i++) {
+            out.prompt("Edge " + to_string(i + 1) + ": ");
+            if (!readEdge(in, V, edges[i])) {
+                throw runtime_error("unexpected end of input");
+            }
+        }
 
-    // Input the edges
-    cout << "Enter the edges in the format (src dest weight):" << endl;
-    for (int i = 0; i < E; i++) {
-        cout << "Edge " << i + 1 << ": ";
-        cin >> edges[i].src >> edges[i].dest >> edges[i].weight;
-    }
+        // Input the source vertex
+        out.prompt("Enter the source vertex: ");
+        int source = in.next<int>();
 
-    // Input the source vertex
-    int source;
-    cout << "Enter the source vertex: ";
-    cin >> source;
+        // Call the Bellman-Ford algorithm
+        vector<int> distance;
+        if (!bellmanFord(edges, V, source, distance)) {
+            out << "Graph contains a negative weight cycle!\n";
+            return 0;
+        }
 
-    // Validate source vertex
-    if (source < 0 || source >= V) {
-        cout << "Invalid source vertex!" << endl;
+        // Print the shortest distances
+        out << "Vertex   Distance from Source\n";
+        for (int i = 0; i < V; i++) {
+            out << i << "         ";
+            if (distance[i] == UNREACHABLE) {
+                out << "INF\n";
+            } else {
+                out << distance[i] << '\n';
+            }
+        }
+        out.flush();
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
         return 1;
     }
 
-    // Call the Bellman-Ford algorithm
-    bellmanFord(edges, V, E, source);
-
     return 0;
 }
 /*
@@ -100,11 +76,15 @@ int main() {
  *  - If a shorter path is found after V-1 iterations, it indicates a negative weight cycle.
  *
  * Functions:
- *  1. `bellmanFord`: Implements the core Bellman-Ford algorithm.
+ *  1. `bellmanFord` (bellman_ford.h): Implements the core Bellman-Ford algorithm and returns
+ *     the distances, or false for a negative weight cycle.
+ *  2. `FastReader` / `FastWriter` (fast_io.h): Parse the input and format the output.
  *
  * Input:
  *  - The user inputs the number of vertices, edges, and the edges in the format `src dest weight`.
  *  - The user also specifies the source vertex.
+ *  - With `--batch [file]` the same values are read without prompts from the file (or from
+ *    standard input), e.g. `./bellman_ford --batch graph.txt`.
  *
  * Output:
  *  - Shortest distances from the source to all vertices, or a message indicating a negative weight cycle.
@@ -135,4 +115,3 @@ int main() {
  *     3         -2
  *     4         1
  */
-
@@ -0,0 +1,212 @@
+#ifndef AHO_CORASICK_H
+#define AHO_CORASICK_H
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace kmp {
+
+/*
+ * Aho-Corasick multi-pattern matcher.
+ * The patterns are inserted into a trie (the goto function). A breadth-first pass then computes
+ * for every state its failure link: the state of the longest proper suffix of its string that is
+ * also a path in the trie. This is the LPS array of KMP generalized from one pattern to a trie.
+ * Missing transitions are resolved through the failure links at build time, so the automaton is
+ * a complete DFA and the search makes exactly one table lookup per text byte, whatever the number
+ * of patterns.
+ * Contains:
+ *  - `classOf`: Alphabet compression. Bytes that occur in no pattern share class 0, every other
+ *    byte gets its own class, so a state's row has `classes` entries instead of 256.
+ *  - `table`: The dense transition table, one row of `classes` entries per state. Entries are
+ *    row offsets of the target state (state * classes), so the search needs no multiplication;
+ *    an entry is stored as -(offset + 1) when the target state reports matches, which makes the
+ *    common "no match here" case a single sign test.
+ *  - `firstOutput`/`outputs`: The patterns ending exactly at each state.
+ *  - `outputLink`: For each state the nearest state on its failure chain at which a pattern
+ *    ends (-1 if none), so every match is reported without walking the whole chain.
+ */
+class AhoCorasick {
+public:
+    struct Match {
+        size_t position; // Index of the first byte of the match in the text
+        int pattern;     // Index of the pattern in the list given to the constructor
+    };
+
+private:
+    std::vector<std::string> patterns;
+    int classOf[256];
+    int classes;
+    std::vector<int32_t> table;
+    std::vector<int> firstOutput; // outputs[firstOutput[s] .. firstOutput[s + 1]) end at state s
+    std::vector<int> outputs;
+    std::vector<int> outputLink;
+
+    // Function to report every pattern ending at `state` after text byte `end` (inclusive)
+    template <typename OnMatch>
+    void report(int state, size_t end, OnMatch& onMatch) const {
+        for (; state >= 0; state = outputLink[state]) {
+            for (int o = firstOutput[state]; o < firstOutput[state + 1]; o++) {
+                onMatch(end + 1 - patterns[outputs[o]].size(), outputs[o]);
+            }
+        }
+    }
+
+public:
+    // Constructor: builds the automaton; throws invalid_argument if there is no or an empty pattern
+    explicit AhoCorasick(const std::vector<std::string>& _patterns) : patterns(_patterns) {
+        if (patterns.empty()) {
+            throw std::invalid_argument("Aho-Corasick needs at least one pattern");
+        }
+
+        // Alphabet compression
+        for (int c = 0; c < 256; c++) {
+            classOf[c] = 0;
+        }
+        classes = 1;
+        for (const std::string& p : patterns) {
+            if (p.empty()) {
+                throw std::invalid_argument("Patterns must not be empty");
+            }
+            for (unsigned char c : p) {
+                if (classOf[c] == 0) {
+                    classOf[c] = classes++;
+                }
+            }
+        }
+
+        // Goto function: the trie, with -1 for missing transitions
+        std::vector<int> next(classes, -1);
+        std::vector<std::vector<int>> ends(1);
+        for (int id = 0; id < (int)patterns.size(); id++) {
+            int state = 0;
+            for (unsigned char c : patterns[id]) {
+                int& edge = next[state * classes + classOf[c]];
+                if (edge < 0) {
+                    if ((ends.size() + 1) * classes > INT32_MAX) {
+                        throw std::length_error("Aho-Corasick table exceeds 2^31 entries");
+                    }
+                    edge = ends.size();
+                    ends.emplace_back();
+                    next.resize(next.size() + classes, -1);
+                }
+                state = next[state * classes + classOf[c]];
+            }
+            ends[state].push_back(id);
+        }
+        int states = ends.size();
+
+        // Failure links in breadth-first order, completing the transitions at the same time
+        std::vector<int> fail(states, 0), link(states, -1);
+        std::vector<int> rank(states, 0); // Position of each state in breadth-first order
+        int ranked = 1;
+        std::queue<int> order;
+        for (int c = 0; c < classes; c++) {
+            int& edge = next[c];
+            if (edge < 0) {
+                edge = 0; // Unmatched bytes stay at the root
+            } else {
+                order.push(edge);
+            }
+        }
+        while (!order.empty()) {
+            int state = order.front();
+            order.pop();
+            rank[state] = ranked++;
+            int f = fail[state];
+            link[state] = !ends[f].empty() ? f : link[f];
+            for (int c = 0; c < classes; c++) {
+                int& edge = next[state * classes + c];
+                if (edge < 0) {
+                    edge = next[f * classes + c]; // Same move as from the failure state
+                } else {
+                    fail[edge] = next[f * classes + c];
+                    order.push(edge);
+                }
+            }
+        }
+
+        /*
+         * Outputs, and the encoded table. States are renumbered in breadth-first order: the
+         * shallow states, where the search spends most of its time, then share a compact
+         * region of the table and stay in the caches.
+         */
+        std::vector<int> byRank(states);
+        for (int s = 0; s < states; s++) {
+            byRank[rank[s]] = s;
+        }
+        firstOutput.assign(states + 1, 0);
+        outputLink.assign(states, -1);
+        table.resize(next.size());
+        for (int r = 0; r < states; r++) {
+            int s = byRank[r];
+            firstOutput[r + 1] = firstOutput[r] + ends[s].size();
+            outputs.insert(outputs.end(), ends[s].begin(), ends[s].end());
+            outputLink[r] = link[s] >= 0 ? rank[link[s]] : -1;
+            for (int c = 0; c < classes; c++) {
+                int target = next[s * classes + c];
+                int32_t offset = rank[target] * classes;
+                bool reports = !ends[target].empty() || link[target] >= 0;
+                table[r * classes + c] = reports ? -offset - 1 : offset;
+            }
+        }
+    }
+
+    /*
+     * Function to find all matches in text[0 .. n), in one pass.
+     * Calls onMatch(position, pattern) for each, ordered by end position.
+     */
+    template <typename OnMatch>
+    void search(const char* text, size_t n, OnMatch onMatch) const {
+        int32_t row = 0;
+        for (size_t i = 0; i < n; i++) {
+            int32_t entry = table[row + classOf[(unsigned char)text[i]]];
+            if (entry >= 0) {
+                row = entry;
+            } else {
+                row = -entry - 1;
+                report(row / classes, i, onMatch);
+            }
+        }
+    }
+
+    // Function to get all matches in the text, ordered by end position
+    std::vector<Match> findAll(const std::string& text) const {
+        std::vector<Match> matches;
+        search(text.data(), text.size(), [&](size_t position, int pattern) {
+            matches.push_back(Match{position, pattern});
+        });
+        return matches;
+    }
+
+    // Function to count all matches in the text
+    size_t count(const std::string& text) const {
+        size_t total = 0;
+        search(text.data(), text.size(), [&](size_t, int) { total++; });
+        return total;
+    }
+
+    const std::string& pattern(int id) const {
+        return patterns[id];
+    }
+
+    int stateCount() const {
+        return table.size() / classes;
+    }
+
+    int alphabetClasses() const {
+        return classes;
+    }
+
+    // Function to get the memory used by the transition table, in bytes
+    size_t tableBytes() const {
+        return table.size() * sizeof(int32_t);
+    }
+};
+
+} // namespace kmp
+
+#endif
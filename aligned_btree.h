@@ -0,0 +1,217 @@
+#ifndef ALIGNED_BTREE_H
+#define ALIGNED_BTREE_H
+
+#include <cstddef>
+#include <climits>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ALIGNED_BTREE_X86 1
+#endif
+
+/*
+ * B-Tree with cache-line-aligned nodes.
+ * Contains:
+ *  - `AlignedBTreeNode<Fanout>`: One node as a single block: keys, key count and child
+ *    pointers are stored inline, and the block starts on a cache-line boundary.
+ *  - `AlignedBTree<Fanout>`: B-Tree of int keys with `insert` and `search`.
+ *  - `fanoutForCacheLines(lines)`: The largest fanout whose node fits in `lines` cache lines.
+ * The fanout (maximum number of children) is a template parameter, so every loop bound in
+ * the node is a compile-time constant and a node is exactly `sizeof(AlignedBTreeNode)` bytes.
+ * Visiting a node costs one pointer dereference into one contiguous block, instead of
+ * loading the node, its key array and its child array from three separate allocations.
+ * Keys in a node are ranked with AVX2 when the CPU has it: eight keys are compared per
+ * instruction and the matches counted with movemask/popcount. The check is made once per
+ * tree at run time, so no -mavx2 is needed; without AVX2 a scalar loop is used.
+ */
+namespace btree {
+
+const int CACHE_LINE_BYTES = 64;
+
+// Function to check whether the CPU can run the AVX2 in-node search
+inline bool alignedBTreeHasAVX2() {
+#ifdef ALIGNED_BTREE_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Number of int slots reserved for keys: rounded up to whole 8-key (32-byte) SIMD blocks
+constexpr int alignedKeySlots(int fanout) {
+    return (fanout - 1 + 7) / 8 * 8;
+}
+
+// Size of a node with the given fanout: keys, then the count and leaf flag, then the children
+constexpr size_t alignedNodeBytes(int fanout) {
+    return alignedKeySlots(fanout) * sizeof(int) + 2 * sizeof(int) + fanout * sizeof(void*);
+}
+
+// Function to get the largest fanout (at least 4) whose node fits in `lines` cache lines
+constexpr int fanoutForCacheLines(int lines) {
+    int fanout = 4;
+    while (alignedNodeBytes(fanout + 1) <= (size_t)lines * CACHE_LINE_BYTES) {
+        fanout++;
+    }
+    return fanout;
+}
+
+template <int Fanout>
+struct alignas(CACHE_LINE_BYTES) AlignedBTreeNode {
+    static_assert(Fanout >= 4, "A node needs room for at least 3 keys");
+    static const int MAX_KEYS = Fanout - 1;
+
+    int keys[alignedKeySlots(Fanout)]; // Sorted keys; slots from n on are unused
+    int n;                             // Current number of keys
+    int leaf;                          // Nonzero if the node is a leaf
+    AlignedBTreeNode* children[Fanout];
+
+    explicit AlignedBTreeNode(bool _leaf) : n(0), leaf(_leaf) {}
+
+    // Function to count the keys smaller than k (the index of the first key >= k)
+    int rank(int k, bool avx2) const {
+#ifdef ALIGNED_BTREE_X86
+        if (avx2) {
+            return rankAVX2(k);
+        }
+#else
+        (void)avx2;
+#endif
+        int i = 0;
+        while (i < n && keys[i] < k) {
+            i++;
+        }
+        return i;
+    }
+
+#ifdef ALIGNED_BTREE_X86
+    // Function to rank k eight keys at a time; only called when the CPU has AVX2
+    __attribute__((target("avx2"))) int rankAVX2(int k) const {
+        __m256i needle = _mm256_set1_epi32(k);
+        int count = 0;
+        for (int i = 0; i < n; i += 8) {
+            __m256i block = _mm256_load_si256((const __m256i*)(keys + i));
+            unsigned less = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+            int valid = n - i;
+            if (valid < 8) {
+                less &= (1u << valid) - 1; // Ignore the unused slots past n
+            }
+            count += __builtin_popcount(less);
+            if (less != 0xFF) {
+                break; // Keys are sorted, so no later block has a smaller key
+            }
+        }
+        return count;
+    }
+#endif
+};
+
+template <int Fanout>
+class AlignedBTree {
+public:
+    typedef AlignedBTreeNode<Fanout> Node;
+
+private:
+    Node* root;
+    bool avx2; // Whether `rank` uses the AVX2 search, decided once from the CPU
+
+    void destroy(Node* node) {
+        if (!node->leaf) {
+            for (int i = 0; i <= node->n; i++) {
+                destroy(node->children[i]);
+            }
+        }
+        delete node;
+    }
+
+    // Function to split the full child parent->children[i]; its middle key moves up
+    void splitChild(Node* parent, int i) {
+        Node* y = parent->children[i];
+        Node* z = new Node(y->leaf);
+        const int mid = Node::MAX_KEYS / 2;
+
+        z->n = Node::MAX_KEYS - mid - 1;
+        for (int j = 0; j < z->n; j++) {
+            z->keys[j] = y->keys[mid + 1 + j];
+        }
+        if (!y->leaf) {
+            for (int j = 0; j <= z->n; j++) {
+                z->children[j] = y->children[mid + 1 + j];
+            }
+        }
+        y->n = mid;
+
+        for (int j = parent->n; j > i; j--) {
+            parent->children[j + 1] = parent->children[j];
+            parent->keys[j] = parent->keys[j - 1];
+        }
+        parent->children[i + 1] = z;
+        parent->keys[i] = y->keys[mid];
+        parent->n++;
+    }
+
+public:
+    AlignedBTree() : root(nullptr), avx2(alignedBTreeHasAVX2()) {}
+
+    ~AlignedBTree() {
+        if (root != nullptr) {
+            destroy(root);
+        }
+    }
+
+    AlignedBTree(const AlignedBTree&) = delete;
+    AlignedBTree& operator=(const AlignedBTree&) = delete;
+
+    // Function to check whether the in-node search runs with AVX2 on this CPU
+    bool usesAVX2() const {
+        return avx2;
+    }
+
+    // Function to check whether key k is in the tree
+    bool search(int k) const {
+        const Node* cur = root;
+        while (cur != nullptr) {
+            int i = cur->rank(k, avx2);
+            if (i < cur->n && cur->keys[i] == k) {
+                return true;
+            }
+            cur = cur->leaf ? nullptr : cur->children[i];
+        }
+        return false;
+    }
+
+    // Function to insert a key; full nodes are split on the way down as in `BTree`
+    void insert(int k) {
+        if (root == nullptr) {
+            root = new Node(true);
+        }
+        if (root->n == Node::MAX_KEYS) {
+            Node* newRoot = new Node(false);
+            newRoot->children[0] = root;
+            root = newRoot;
+            splitChild(root, 0);
+        }
+
+        Node* cur = root;
+        while (!cur->leaf) {
+            int i = cur->rank(k, avx2);
+            if (cur->children[i]->n == Node::MAX_KEYS) {
+                splitChild(cur, i);
+                if (cur->keys[i] < k) {
+                    i++;
+                }
+            }
+            cur = cur->children[i];
+        }
+
+        int i = cur->rank(k, avx2);
+        for (int j = cur->n; j > i; j--) {
+            cur->keys[j] = cur->keys[j - 1];
+        }
+        cur->keys[i] = k;
+        cur->n++;
+    }
+};
+
+} // namespace btree
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef APPROXIMATE_MATCH_H
+#define APPROXIMATE_MATCH_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Bit-parallel approximate pattern matching.
+ * Contains:
+ *  - `HammingMatcher`: Occurrences with at most k mismatched characters (Wu-Manber Bitap).
+ *  - `EditDistanceMatcher`: Substrings within edit distance k of the pattern (Myers).
+ * Both keep one bit per pattern position in 64-bit words, so a pattern of m characters takes
+ * ceil(m / 64) words per bit vector and patterns of any length are supported. Both keep their
+ * state between calls to `feed`, so the text can be given in chunks (e.g. with searchFile of
+ * streaming_kmp.h) and matches are reported with absolute offsets.
+ */
+namespace kmp {
+
+// Function to build the per-character bit masks of a pattern: bit i of masks[c] is set if pattern[i] == c
+inline std::vector<uint64_t> patternMasks(const std::string& pattern, size_t words) {
+    std::vector<uint64_t> masks(256 * words, 0);
+    for (size_t i = 0; i < pattern.size(); i++) {
+        masks[(unsigned char)pattern[i] * words + i / 64] |= 1ULL << (i % 64);
+    }
+    return masks;
+}
+
+/*
+ * k-mismatch matcher (Wu-Manber extension of Shift-And).
+ * Contains:
+ *  - `state[d]`: Bit i is set if the last i + 1 text characters equal the first i + 1 pattern
+ *    characters with at most d mismatches. For each text character c:
+ *      state'[d] = ((state[d] << 1 | 1) & masks[c]) | (state[d - 1] << 1 | 1)
+ *    The first term extends a match with an equal character, the second with a mismatch.
+ * A match is reported at the smallest d whose bit m - 1 is set. Cost: O(k * m / 64) per character.
+ */
+class HammingMatcher {
+private:
+    size_t m, words;
+    int k;
+    std::vector<uint64_t> masks;
+    std::vector<uint64_t> state; // (k + 1) vectors of `words` words
+    std::vector<uint64_t> previous;
+    uint64_t consumed;
+
+public:
+    // Constructor: throws invalid_argument for an empty pattern or k outside [0, m)
+    HammingMatcher(const std::string& pattern, int _k)
+        : m(pattern.size()), words((pattern.size() + 63) / 64), k(_k), consumed(0) {
+        if (m == 0) {
+            throw std::invalid_argument("The pattern must not be empty");
+        }
+        if (k < 0 || (size_t)k >= m) {
+            throw std::invalid_argument("k must be at least 0 and less than the pattern length");
+        }
+        masks = patternMasks(pattern, words);
+        state.assign((k + 1) * words, 0);
+        previous.assign(words, 0);
+    }
+
+    /*
+     * Function to search the next chunk of the text.
+     * Calls onMatch(offset, distance) with the absolute starting offset of every occurrence
+     * with at most k mismatches, and its number of mismatches.
+     */
+    template <typename OnMatch>
+    void feed(const char* data, size_t n, OnMatch onMatch) {
+        size_t last = (m - 1) / 64;
+        uint64_t lastBit = 1ULL << ((m - 1) % 64);
+        for (size_t i = 0; i < n; i++) {
+            const uint64_t* mask = &masks[(unsigned char)data[i] * words];
+            int distance = -1;
+            for (int d = 0; d <= k; d++) {
+                uint64_t* row = &state[d * words];
+                uint64_t carry = 1, carryPrevious = 1; // Bit 0: the empty prefix always matches
+                for (size_t w = 0; w < words; w++) {
+                    uint64_t shifted = (row[w] << 1) | carry;
+                    carry = row[w] >> 63;
+                    uint64_t next = shifted & mask[w];
+                    if (d > 0) {
+                        // previous holds state[d - 1] from before this character
+                        next |= (previous[w] << 1) | carryPrevious;
+                        carryPrevious = previous[w] >> 63;
+                    }
+                    previous[w] = row[w];
+                    row[w] = next;
+                }
+                if (distance < 0 && (row[last] & lastBit)) {
+                    distance = d;
+                }
+            }
+            if (distance >= 0 && consumed + i + 1 >= m) {
+                onMatch(consumed + i + 1 - m, distance);
+            }
+        }
+        consumed += n;
+    }
+
+    // Function to start over with a new text
+    void reset() {
+        std::fill(state.begin(), state.end(), 0);
+        consumed = 0;
+    }
+
+    // Function to get the number of text bytes fed so far
+    uint64_t position() const {
+        return consumed;
+    }
+};
+
+/*
+ * Edit-distance matcher (Myers' bit-vector algorithm, with Hyyro's blocks for long patterns).
+ * It computes the last column of the dynamic-programming table of approximate matching,
+ * where D[i][j] is the smallest edit distance between pattern[0 .. i] and any substring of
+ * the text ending at j, without storing the table: each column is kept as two bit vectors
+ * of vertical differences D[i][j] - D[i - 1][j], `plus` (difference +1) and `minus` (-1).
+ * A text character updates all m rows with a few word operations; the carries between the
+ * words of a long pattern are the horizontal differences of each block's top row.
+ * `score` is D[m - 1][j]; a match ends at every position where it is at most k.
+ * Cost: O(m / 64) per character.
+ */
+class EditDistanceMatcher {
+private:
+    size_t m, words;
+    int k;
+    std::vector<uint64_t> masks;
+    std::vector<uint64_t> plus, minus;
+    int score;
+    uint64_t consumed;
+
+    /*
+     * Function to advance one 64-row block by one text character.
+     * `hin` is the horizontal difference entering the block from below (-1, 0 or +1);
+     * returns the horizontal difference at `topBit`, the block's highest row.
+     */
+    static int advanceBlock(uint64_t& pv, uint64_t& mv, uint64_t eq, int hin, uint64_t topBit) {
+        uint64_t xv = eq | mv;
+        if (hin < 0) {
+            eq |= 1;
+        }
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        int hout = (ph & topBit) ? 1 : ((mh & topBit) ? -1 : 0);
+        ph <<= 1;
+        mh <<= 1;
+        if (hin < 0) {
+            mh |= 1;
+        } else if (hin > 0) {
+            ph |= 1;
+        }
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        return hout;
+    }
+
+public:
+    // Constructor: throws invalid_argument for an empty pattern or k outside [0, m)
+    EditDistanceMatcher(const std::string& pattern, int _k)
+        : m(pattern.size()), words((pattern.size() + 63) / 64), k(_k), score(pattern.size()), consumed(0) {
+        if (m == 0) {
+            throw std::invalid_argument("The pattern must not be empty");
+        }
+        if (k < 0 || (size_t)k >= m) {
+            throw std::invalid_argument("k must be at least 0 and less than the pattern length");
+        }
+        masks = patternMasks(pattern, words);
+        plus.assign(words, ~0ULL); // D[i][-1] = i + 1: every vertical difference is +1
+        minus.assign(words, 0);
+    }
+
+    /*
+     * Function to search the next chunk of the text.
+     * Calls onMatch(end, distance) for every absolute offset `end` at which a substring
+     * within edit distance k of the pattern ends, with the smallest such distance.
+     */
+    template <typename OnMatch>
+    void feed(const char* data, size_t n, OnMatch onMatch) {
+        uint64_t lastTop = 1ULL << ((m - 1) % 64);
+        for (size_t i = 0; i < n; i++) {
+            const uint64_t* mask = &masks[(unsigned char)data[i] * words];
+            int carry = 0; // Row -1 is all zeros: a match may start anywhere
+            for (size_t w = 0; w < words; w++) {
+                // Rows above m - 1 in the last word never influence the rows below them
+                carry = advanceBlock(plus[w], minus[w], mask[w], carry, w + 1 == words ? lastTop : 1ULL << 63);
+            }
+            score += carry;
+            if (score <= k) {
+                onMatch(consumed + i, score);
+            }
+        }
+        consumed += n;
+    }
+
+    // Function to start over with a new text
+    void reset() {
+        std::fill(plus.begin(), plus.end(), ~0ULL);
+        std::fill(minus.begin(), minus.end(), 0);
+        score = m;
+        consumed = 0;
+    }
+
+    // Function to get the number of text bytes fed so far
+    uint64_t position() const {
+        return consumed;
+    }
+};
+
+} // namespace kmp
+
+#endif
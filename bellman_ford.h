@@ -0,0 +1,71 @@
+#ifndef BELLMAN_FORD_H
+#define BELLMAN_FORD_H
+
+#include <vector>
+#include <climits>
+#include <stdexcept>
+
+/*
+ * Single-source shortest paths with the Bellman-Ford algorithm.
+ * Contains:
+ *  - `Edge`: A directed, weighted edge.
+ *  - `bellmanFord`: Shortest distances from a source, or the report of a negative weight cycle.
+ */
+namespace bellman_ford {
+
+/*
+ * Structure to represent an edge of the graph.
+ * Contains:
+ *  - `src`: Source vertex
+ *  - `dest`: Destination vertex
+ *  - `weight`: Weight of the edge
+ */
+struct Edge {
+    int src, dest, weight;
+};
+
+// Distance of a vertex that cannot be reached from the source
+const int UNREACHABLE = INT_MAX;
+
+/*
+ * Function to implement the Bellman-Ford algorithm.
+ * Parameters:
+ *  - edges: Vector of edges representing the graph
+ *  - V: Number of vertices
+ *  - source: The source vertex from which shortest paths are calculated
+ *  - distance: Receives the shortest distance to every vertex (UNREACHABLE if there is no path)
+ * Returns:
+ *  - False if a negative weight cycle is reachable from the source (the distances are then
+ *    not meaningful), true otherwise.
+ * Throws invalid_argument if the source is not a vertex.
+ */
+inline bool bellmanFord(const std::vector<Edge>& edges, int V, int source, std::vector<int>& distance) {
+    if (source < 0 || source >= V) {
+        throw std::invalid_argument("Invalid source vertex!");
+    }
+
+    // Initialize distances from source to all vertices as infinite (INT_MAX)
+    distance.assign(V, UNREACHABLE);
+    distance[source] = 0;
+
+    // Relax all edges (V-1) times
+    for (int i = 1; i <= V - 1; i++) {
+        for (const Edge& edge : edges) {
+            if (distance[edge.src] != UNREACHABLE && distance[edge.src] + edge.weight < distance[edge.dest]) {
+                distance[edge.dest] = distance[edge.src] + edge.weight;
+            }
+        }
+    }
+
+    // Check for negative weight cycles
+    for (const Edge& edge : edges) {
+        if (distance[edge.src] != UNREACHABLE && distance[edge.src] + edge.weight < distance[edge.dest]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace bellman_ford
+
+#endif
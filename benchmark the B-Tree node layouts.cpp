@@ -0,0 +1,98 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include "aligned_btree.h"
+#include "btree.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace btree;
+
+/*
+ * Function to benchmark lookups in one aligned layout against the pointer-array `BTree` of the
+ * same fanout (minimum degree t = Fanout / 2) on the same keys and probes.
+ */
+template <int Fanout>
+void compareLayouts(bench::Runner& runner, int lines, const vector<int>& keys, const vector<int>& probes) {
+    btree::BTree pointerTree(Fanout / 2);
+    AlignedBTree<Fanout> alignedTree;
+    for (int key : keys) {
+        pointerTree.insert(key);
+        alignedTree.insert(key);
+    }
+    string suffix = bench::param("n", keys.size()) + bench::param("lines", lines) + bench::param("fanout", Fanout);
+
+    uint64_t pointerHits = runner.run("BTree.search" + suffix, probes.size(), [&]() {
+        uint64_t hits = 0;
+        for (int key : probes) hits += pointerTree.search(key) != nullptr;
+        return hits;
+    });
+    uint64_t alignedHits = runner.run("AlignedBTree.search" + suffix, probes.size(), []() {}, [&]() {
+        uint64_t hits = 0;
+        for (int key : probes) hits += alignedTree.search(key);
+        return hits;
+    }, [&]() {
+        runner.record("node_bytes", sizeof(typename AlignedBTree<Fanout>::Node));
+        runner.record("avx2", alignedTree.usesAVX2());
+    });
+    if (runner.selected("BTree.search" + suffix) && runner.selected("AlignedBTree.search" + suffix) &&
+        pointerHits != alignedHits) {
+        throw runtime_error("AlignedBTree.search" + suffix + " disagrees with BTree.search");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("btree_layouts", options);
+        size_t lookups = runner.scaled(1000000);
+
+        for (long long size : {1000, 10000, 100000, 1000000}) {
+            int n = runner.scaled(size, 16);
+            bench::Random rng(options.seed + n);
+            vector<int> keys(n);
+            for (int& key : keys) {
+                key = (int)(rng.next() & 0x7FFFFFFF);
+            }
+            // Half of the probes are inserted keys, half are random (mostly misses)
+            vector<int> probes(lookups);
+            for (size_t i = 0; i < probes.size(); i++) {
+                probes[i] = (i % 2 == 0) ? keys[rng.below(n)] : (int)(rng.next() & 0x7FFFFFFF);
+            }
+
+            compareLayouts<fanoutForCacheLines(2)>(runner, 2, keys, probes);
+            compareLayouts<fanoutForCacheLines(4)>(runner, 4, keys, probes);
+            compareLayouts<fanoutForCacheLines(8)>(runner, 8, keys, probes);
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * B-Tree Node Layout Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures lookup throughput of the cache-line-aligned `AlignedBTree` (aligned_btree.h)
+ *    against the `BTree` of the B-Tree program, whose nodes keep keys and child pointers in
+ *    two separate heap arrays.
+ *
+ * Cases:
+ *  - Trees of 1000 to 1000000 random keys, and 1000000 lookups per repetition.
+ *  - Each aligned node fills 2, 4 or 8 cache lines; the pointer-array tree gets the same
+ *    fanout, so both trees have the same height and only the node layout and the in-node
+ *    search differ.
+ *  - The same keys and the same probe sequence (half hits, half misses) are used for both
+ *    trees, and the hit counts must agree.
+ *  - ns_per_item is per lookup.
+ *
+ * Extra fields:
+ *  - `node_bytes`: Size of one aligned node.
+ *  - `avx2`: 1 if the aligned tree uses the AVX2 in-node search, 0 if the CPU has no AVX2
+ *    and it uses a scalar loop, in which case the difference is the layout alone.
+ *
+ * Usage:
+ *  - `--scale` multiplies the numbers of keys and lookups.
+ */
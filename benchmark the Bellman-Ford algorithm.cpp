@@ -0,0 +1,77 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include "bellman_ford.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace bellman_ford;
+
+/*
+ * Function to give a graph negative weights without creating a negative cycle.
+ * Every vertex gets a random potential p, and each edge u -> v the weight w + p(u) - p(v):
+ * the potentials cancel around any cycle, so cycle weights stay non-negative, while about
+ * half of the edges become negative (the same reweighting Johnson's algorithm undoes).
+ */
+void addPotentials(vector<Edge>& edges, int V, int range, uint64_t seed) {
+    bench::Random rng(seed);
+    vector<int> potential(V);
+    for (int& p : potential) p = (int)rng.below(range);
+    for (Edge& edge : edges) {
+        edge.weight += potential[edge.src] - potential[edge.dest];
+    }
+}
+
+// Function to fold the distances into a checksum (unreachable vertices included)
+uint64_t distanceChecksum(const vector<int>& distance) {
+    uint64_t sum = 0;
+    for (int d : distance) sum = sum * 1000003 + (uint32_t)d;
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("bellman_ford", options);
+        int V = runner.scaled(1000, 2);
+
+        for (double density : {0.005, 0.05, 0.25}) {
+            for (bool negative : {false, true}) {
+                vector<Edge> edges = bench::randomGraph<Edge>(V, density, options.seed, 0, 1000, true);
+                if (negative) addPotentials(edges, V, 1000, options.seed + 1);
+
+                string name = string("bellmanFord") + bench::param("V", V) + bench::param("density", density) +
+                              bench::param("weights", string(negative ? "mixed" : "non-negative"));
+                vector<int> distance;
+                runner.run(name, (double)V * edges.size(), [&]() {
+                    if (!bellmanFord(edges, V, 0, distance)) {
+                        throw runtime_error("unexpected negative weight cycle");
+                    }
+                    return distanceChecksum(distance);
+                });
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Bellman-Ford Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Tracks the speed of `bellmanFord` (bellman_ford.h) from commit to commit.
+ *
+ * Cases:
+ *  - Connected random graphs (benchmark_harness.h) on V = 1000 vertices at densities of
+ *    0.5%, 5% and 25% of all vertex pairs.
+ *  - Non-negative weights, and mixed weights from random vertex potentials, which make
+ *    about half of the edges negative without creating a negative cycle.
+ *  - The reported item count is V * E, the work of the V-1 relaxation passes.
+ *
+ * Usage:
+ *  - The options are those of `parseOptions` in benchmark_harness.h; `--scale` multiplies V.
+ *  - The checksum covers all distances, so a change of result is reported with the timings.
+ */
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include "kmp_prefilter.h"
+#include "kmp.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace kmp;
+
+// Function to time one pattern with the KMP loop and every prefilter configuration the CPU supports
+void benchmarkPattern(bench::Runner& runner, const string& name, const string& text, const string& pattern) {
+    string suffix = bench::param("bytes", text.size()) + bench::param("pattern", name);
+    uint64_t expected = runner.run("KMPfindAll" + suffix, text.size(), [&]() {
+        return (uint64_t)kmp::KMPfindAll(text, pattern).size();
+    });
+
+    const PrefilterISA sets[] = {PREFILTER_AVX2, PREFILTER_AVX512};
+    const PrefilterAnchors anchors[] = {ANCHOR_FIRST_LAST, ANCHOR_RARE_BYTES};
+    for (PrefilterISA set : sets) {
+        for (PrefilterAnchors anchor : anchors) {
+            PrefilteredKMP matcher(pattern, anchor, set);
+            if (matcher.instructionSet() != set) continue; // Not supported by this CPU
+            string config = bench::param("isa", string(matcher.instructionSetName())) +
+                            bench::param("anchors", string(anchor == ANCHOR_RARE_BYTES ? "rare" : "first-last"));
+            uint64_t matches = runner.run("PrefilteredKMP" + config + suffix, text.size(), [&]() {
+                uint64_t count = 0;
+                matcher.search(text.data(), text.size(), [&](size_t) { count++; });
+                return count;
+            });
+            if (runner.selected("KMPfindAll" + suffix) && runner.selected("PrefilteredKMP" + config + suffix) &&
+                matches != expected) {
+                throw runtime_error("PrefilteredKMP" + config + suffix + " disagrees with KMPfindAll");
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("kmp_prefilter", options);
+        size_t n = runner.scaled(64 << 20, 1024);
+        string text = bench::logText(n, options.seed);
+
+        benchmarkPattern(runner, "absent", text, "ERROR disk quota exceeded");
+        benchmarkPattern(runner, "rare", text, text.substr(text.size() / 2, 24));
+        benchmarkPattern(runner, "common-word", text, " INFO user=");
+        benchmarkPattern(runner, "dense-candidates", string(n, 'a'), "aaaabaaa");
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * KMP Prefilter Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures the scan rate of the KMP program's `KMPfindAll` loop against `PrefilteredKMP`
+ *    (kmp_prefilter.h) with AVX2 and AVX-512, using the first/last pattern bytes or the two
+ *    rarest bytes as anchors.
+ *
+ * Cases:
+ *  - A 64 MB text of log lines from `logText`. "absent" never occurs, "rare" occurs about
+ *    once, and " INFO user=" occurs on a quarter of the lines, so candidates are frequent.
+ *  - "dense-candidates" searches a run of 'a's for "aaaabaaa": the first/last anchors match
+ *    at every position, so the prefilter gives up early and Shift-Or runs instead; the
+ *    rare-byte anchors include the 'b' and reject every position.
+ *  - The synthetic words use all letters equally often, so the rare-byte heuristic (tuned
+ *    for English and logs) has less to gain here than on real logs.
+ *  - Configurations the CPU does not support are skipped; all must agree on the match count.
+ *  - ns_per_item is per text byte.
+ *
+ * Usage:
+ *  - `--scale` multiplies the text size. The cases present depend on the CPU, so results are
+ *    only comparable between runs on the same machine.
+ */
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include "kmp.h"
+#include "kmp_prefilter.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace kmp;
+
+// Function to fold match positions into a checksum (count and positions)
+template <typename Position>
+uint64_t matchChecksum(const vector<Position>& matches) {
+    uint64_t sum = matches.size();
+    for (Position p : matches) sum = sum * 31 + (uint64_t)p;
+    return sum;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("kmp", options);
+        size_t n = runner.scaled(16 << 20, 1024);
+
+        for (int alphabet : {4, 26}) {
+            for (double repetitiveness : {0.0, 0.9}) {
+                string text = bench::textCorpus(n, alphabet, repetitiveness, options.seed);
+                for (size_t m : {8, 64}) {
+                    // A pattern taken from the middle of the text, so that it occurs at least once
+                    string pattern = text.substr(n / 2, m);
+                    string suffix = bench::param("bytes", n) + bench::param("alphabet", alphabet) +
+                                    bench::param("repetitiveness", repetitiveness) + bench::param("m", m);
+
+                    uint64_t expected = runner.run("KMPfindAll" + suffix, n, [&]() {
+                        return matchChecksum(kmp::KMPfindAll(text, pattern));
+                    });
+                    PrefilteredKMP prefiltered(pattern);
+                    uint64_t found = runner.run("PrefilteredKMP" + suffix, n, [&]() {
+                        return matchChecksum(prefiltered.findAll(text));
+                    });
+                    if (runner.selected("KMPfindAll" + suffix) && runner.selected("PrefilteredKMP" + suffix) &&
+                        found != expected) {
+                        throw runtime_error("PrefilteredKMP" + suffix + " disagrees with KMPfindAll");
+                    }
+                }
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * KMP Search Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Tracks the plain KMP loop (`KMPfindAll` in kmp.h) and the search behind the KMP
+ *    program's `KMPsearch` (`PrefilteredKMP` in kmp_prefilter.h) between commits.
+ *
+ * Cases:
+ *  - 16 MB texts from `textCorpus` over 4 and 26 letters, random or with 90% of the text
+ *    copied from earlier positions. Repeats make the pattern's prefixes recur, so the KMP
+ *    loop falls back through the LPS array more often and the prefilter finds more candidates.
+ *  - Patterns of 8 and 64 bytes cut from the middle of the text.
+ *  - Both engines return all match positions; their checksums must agree.
+ *  - ns_per_item is per text byte.
+ *
+ * Usage:
+ *  - `--scale` multiplies the text size. The prefilter uses AVX2 or AVX-512 when the CPU has it,
+ *    so results are only comparable between runs on the same machine.
+ */
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include "approximate_match.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace kmp;
+
+// Function to count positions where the pattern occurs with at most k mismatches, checking every position
+uint64_t naiveHamming(const string& text, const string& pattern, int k) {
+    uint64_t count = 0;
+    for (size_t s = 0; s + pattern.size() <= text.size(); s++) {
+        int mismatches = 0;
+        for (size_t i = 0; i < pattern.size() && mismatches <= k; i++) {
+            mismatches += text[s + i] != pattern[i];
+        }
+        count += mismatches <= k;
+    }
+    return count;
+}
+
+// Function to count end positions of substrings within edit distance k (Sellers' dynamic programming)
+uint64_t sellersEditDistance(const string& text, const string& pattern, int k) {
+    size_t m = pattern.size();
+    uint64_t count = 0;
+    vector<int> column(m + 1);
+    for (size_t i = 0; i <= m; i++) {
+        column[i] = i;
+    }
+    for (char c : text) {
+        int diagonal = column[0];
+        column[0] = 0; // A match may start anywhere
+        for (size_t i = 1; i <= m; i++) {
+            int up = column[i];
+            column[i] = min({column[i] + 1, column[i - 1] + 1, diagonal + (pattern[i - 1] != c)});
+            diagonal = up;
+        }
+        count += column[m] <= k;
+    }
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("approximate_match", options);
+        bench::Random rng(options.seed);
+        string text = bench::randomText(runner.scaled(16 << 20, 1024), "ACGT", rng);
+        // The direct methods run on a prefix of the text, and are checked against the matchers on it
+        string prefix = text.substr(0, min<size_t>(text.size(), 1 << 20));
+
+        for (size_t m : {16, 64, 256}) {
+            for (int k : {1, 4}) {
+                // A pattern copied from the text, so there is at least one exact occurrence
+                string pattern = text.substr(rng.below(text.size() - m), m);
+                string suffix = bench::param("bytes", text.size()) + bench::param("m", m) + bench::param("k", k);
+
+                uint64_t naiveMatches = runner.run("naiveHamming" + suffix, prefix.size(), [&]() {
+                    return naiveHamming(prefix, pattern, k);
+                });
+                uint64_t sellersMatches = runner.run("sellersEditDistance" + suffix, prefix.size(), [&]() {
+                    return sellersEditDistance(prefix, pattern, k);
+                });
+
+                uint64_t prefixHamming = 0, prefixEdit = 0;
+                runner.run("HammingMatcher" + suffix, text.size(), [&]() {
+                    HammingMatcher matcher(pattern, k);
+                    uint64_t count = 0;
+                    prefixHamming = 0;
+                    matcher.feed(text.data(), text.size(), [&](uint64_t start, int) {
+                        count++;
+                        prefixHamming += start + m <= prefix.size();
+                    });
+                    return count;
+                });
+                runner.run("EditDistanceMatcher" + suffix, text.size(), [&]() {
+                    EditDistanceMatcher matcher(pattern, k);
+                    uint64_t count = 0;
+                    prefixEdit = 0;
+                    matcher.feed(text.data(), text.size(), [&](uint64_t end, int) {
+                        count++;
+                        prefixEdit += end < prefix.size();
+                    });
+                    return count;
+                });
+
+                if ((runner.selected("naiveHamming" + suffix) && runner.selected("HammingMatcher" + suffix) &&
+                     naiveMatches != prefixHamming) ||
+                    (runner.selected("sellersEditDistance" + suffix) && runner.selected("EditDistanceMatcher" + suffix) &&
+                     sellersMatches != prefixEdit)) {
+                    throw runtime_error("the matchers disagree with the direct methods on" + suffix);
+                }
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Approximate Matching Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Compares the bit-parallel matchers of approximate_match.h with the direct methods:
+ *    Bitap (`HammingMatcher`) against checking every text position for k mismatches, and
+ *    Myers' algorithm (`EditDistanceMatcher`) against Sellers' dynamic programming for edit
+ *    distance.
+ *
+ * Cases:
+ *  - A 16 MB random DNA-like sequence over ACGT from `randomText`; patterns of 16, 64 and
+ *    256 bytes are copied from it, so each occurs at least once exactly and many times
+ *    approximately, with k = 1 and 4 allowed differences.
+ *  - The naive check stops at k + 1 mismatches, so it is fastest for small k and a large
+ *    alphabet; Sellers' method always fills all m rows of a column per character.
+ *  - Bitap costs O(k * m / 64) and Myers O(m / 64) word operations per character, so both
+ *    slow down only once the pattern needs more than one 64-bit word.
+ *  - The direct methods run on the first MB of the text; their match counts must equal the
+ *    matchers' counts on that prefix.
+ *  - ns_per_item is per byte searched (the prefix for the direct methods).
+ *
+ * Usage:
+ *  - `--scale` multiplies the text size.
+ */
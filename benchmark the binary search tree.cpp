@@ -0,0 +1,65 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+#include "binary_search_tree.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace bst;
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("bst", options);
+
+        const vector<string> distributions = {"random", "zipf", "few-unique", "nearly-sorted", "sorted"};
+        for (const string& distribution : distributions) {
+            // An unbalanced tree degenerates to a list on (nearly) sorted keys: O(n^2) inserts, so fewer keys
+            bool degenerate = distribution == "sorted" || distribution == "nearly-sorted";
+            int n = runner.scaled(degenerate ? 10000 : 1000000);
+            vector<int> keys = bench::generateKeys(distribution, n, options.seed);
+            string suffix = bench::param("n", n) + bench::param("keys", distribution);
+
+            runner.run("insert" + suffix, n, [&]() {
+                BinarySearchTree tree;
+                for (int key : keys) tree.insert(key);
+                return (uint64_t)tree.search(keys[n / 2]);
+            });
+
+            // Searches for every key, half of them shifted so that about half of the searches miss
+            BinarySearchTree tree;
+            for (int key : keys) tree.insert(key);
+            runner.run("search" + suffix, n, [&]() {
+                uint64_t found = 0;
+                for (int i = 0; i < n; i++) {
+                    found += tree.search(i % 2 == 0 ? keys[i] : keys[i] ^ 0x40000000);
+                }
+                return found;
+            });
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Binary Search Tree Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures `BinarySearchTree` (binary_search_tree.h) insert and search for regression
+ *    tracking, with the allocation counts that show its one heap node per key.
+ *
+ * Cases:
+ *  - Key distributions from `generateKeys`: random, zipf and few-unique keys with 1 million
+ *    keys; sorted and nearly-sorted keys, which turn the unbalanced tree into a list, with
+ *    10 thousand keys so that the O(n^2) insertion finishes.
+ *  - `insert` builds a fresh tree from all keys and destroys it, both timed.
+ *  - `search` looks up every key in a tree built once beforehand; every second lookup is
+ *    for a key with bit 30 flipped, which is usually absent.
+ *
+ * Usage:
+ *  - `--scale` multiplies the key counts; `--filter keys=random` keeps one distribution.
+ */
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <map>
+#include <shared_mutex>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include "concurrent_btree.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace btree;
+
+/*
+ * Zipfian distribution over the records 0 .. n-1 (Gray et al., as used by YCSB): record i is
+ * chosen with probability proportional to 1 / (i + 1)^theta. The normalization constant is
+ * computed once and shared; each thread draws with its own random source.
+ */
+class ZipfianGenerator {
+private:
+    long long n;
+    double theta, alpha, zetan, eta;
+
+public:
+    ZipfianGenerator(long long _n, double _theta) : n(_n), theta(_theta) {
+        double zeta2 = 1 + pow(0.5, theta);
+        zetan = 0;
+        for (long long i = 1; i <= n; i++) {
+            zetan += 1 / pow((double)i, theta);
+        }
+        alpha = 1 / (1 - theta);
+        eta = (1 - pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    long long next(bench::Random& rng) const {
+        double u = rng.unit();
+        double uz = u * zetan;
+        if (uz < 1) return 0;
+        if (uz < 1 + pow(0.5, theta)) return 1;
+        long long i = (long long)(n * pow(eta * u - eta + 1, alpha));
+        return i < n ? i : n - 1;
+    }
+};
+
+// Function to map a record number to its key; a bijection on 31 bits, so popular records are spread out
+int keyOf(long long record) {
+    return (int)((uint32_t)(record * 2654435761u) & 0x7FFFFFFF);
+}
+
+// One YCSB workload: the share of reads, updates, scans and inserts (the rest)
+struct Workload {
+    const char* name;
+    double read, update, scan;
+};
+
+// The baseline: std::map guarded by a reader-writer lock, with the interface of ConcurrentBTree
+struct LockedMap {
+    map<int, int> entries;
+    shared_mutex lock;
+
+    bool search(int k, int& value) {
+        shared_lock<shared_mutex> guard(lock);
+        map<int, int>::iterator it = entries.find(k);
+        if (it == entries.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    void insert(int k, int value) {
+        unique_lock<shared_mutex> guard(lock);
+        entries[k] = value;
+    }
+
+    vector<pair<int, int>> scan(int lo, int limit) {
+        shared_lock<shared_mutex> guard(lock);
+        vector<pair<int, int>> result;
+        for (map<int, int>::iterator it = entries.lower_bound(lo); it != entries.end() && (int)result.size() < limit; ++it) {
+            result.push_back(*it);
+        }
+        return result;
+    }
+};
+
+/*
+ * Function to load records 0 .. records-1 into a fresh index and run one workload on it at
+ * every thread count, each thread count as one case. Inserts add new records after the loaded
+ * ones, so the index keeps growing under workload E.
+ * The checksum counts successful reads plus the number of scans: every read finds a loaded
+ * record and updates never remove one, so it does not depend on how the threads interleave.
+ * The records returned by the scans are recorded as the extra field `scanned` of workload E.
+ */
+template <typename Index>
+void benchmarkIndex(bench::Runner& runner, const string& engine, const Workload& workload,
+                    const ZipfianGenerator& zipf, long long records, long long totalOps, int maxThreads) {
+    Index index;
+    for (long long r = 0; r < records; r++) {
+        index.insert(keyOf(r), (int)r);
+    }
+    atomic<long long> nextRecord(records);
+
+    for (int threads : bench::threadCounts(maxThreads)) {
+        long long ops = totalOps / threads;
+        atomic<uint64_t> scanned(0);
+        runner.run(engine + bench::param("records", records) + bench::param("workload", string(workload.name)) +
+                       bench::param("threads", threads),
+                   ops * threads, [&]() { scanned = 0; }, [&]() {
+            atomic<uint64_t> sum(0);
+            vector<thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&, t]() {
+                    bench::Random rng(runner.config().seed + t);
+                    uint64_t local = 0, localScanned = 0;
+                    for (long long i = 0; i < ops; i++) {
+                        double c = rng.unit();
+                        if (c < workload.read) {
+                            int value;
+                            local += index.search(keyOf(zipf.next(rng)), value);
+                        } else if (c < workload.read + workload.update) {
+                            index.insert(keyOf(zipf.next(rng)), (int)i);
+                        } else if (c < workload.read + workload.update + workload.scan) {
+                            long long record = zipf.next(rng);
+                            localScanned += index.scan(keyOf(record), 1 + rng.below(100)).size();
+                            local++;
+                        } else {
+                            index.insert(keyOf(nextRecord.fetch_add(1)), (int)i);
+                        }
+                    }
+                    sum += local;
+                    scanned += localScanned;
+                });
+            }
+            for (thread& worker : workers) {
+                worker.join();
+            }
+            return sum.load();
+        }, [&]() {
+            if (workload.scan > 0) runner.record("scanned", scanned.load());
+        });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("concurrent_btree", options);
+        long long records = runner.scaled(1000000, 16);
+        long long totalOps = runner.scaled(1000000, 16);
+        // Twice as many threads as cores, to include a run where lock holders get preempted
+        int maxThreads = 2 * max(1u, thread::hardware_concurrency());
+
+        const Workload workloads[] = {
+            {"A", 0.50, 0.50, 0.00}, // Update heavy
+            {"B", 0.95, 0.05, 0.00}, // Read mostly
+            {"C", 1.00, 0.00, 0.00}, // Read only
+            {"E", 0.00, 0.00, 0.95}, // Short ranges; the remaining 5% insert new records
+        };
+        ZipfianGenerator zipf(records, 0.99);
+        for (const Workload& workload : workloads) {
+            benchmarkIndex<ConcurrentBTree>(runner, "ConcurrentBTree", workload, zipf, records, totalOps, maxThreads);
+            benchmarkIndex<LockedMap>(runner, "LockedMap", workload, zipf, records, totalOps, maxThreads);
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Concurrent B-Tree Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures the throughput of `ConcurrentBTree` (concurrent_btree.h, optimistic lock
+ *    coupling) under the YCSB core workloads at 1, 2, 4, ... threads, against a std::map
+ *    guarded by a reader-writer lock (`LockedMap`).
+ *
+ * Cases:
+ *  - 1000000 records are loaded first; operations then pick records with a Zipfian
+ *    distribution (theta 0.99), so a few records are very popular, as in YCSB.
+ *  - Workloads: A = 50% reads / 50% updates, B = 95% reads / 5% updates, C = reads only,
+ *    E = 95% scans of 1-100 records / 5% inserts of new records.
+ *  - Every repetition performs 1000000 operations split over the threads; ns_per_item is per
+ *    operation, and includes starting and joining the threads.
+ *  - Thread counts go up to twice the number of hardware threads. With more threads than
+ *    cores, threads are time-sliced and throughput cannot scale; the case is still useful to
+ *    see how each structure behaves when a lock holder is preempted.
+ *
+ * Extra fields:
+ *  - `scanned`: Records returned by the scans of workload E, which depends on the inserts
+ *    running at the same time.
+ *
+ * Usage:
+ *  - `--scale` multiplies the numbers of records and operations.
+ */
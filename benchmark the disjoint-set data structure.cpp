@@ -0,0 +1,189 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
+#include "disjoint_set.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace mst;
+
+/*
+ * The union-find layout used by the Kruskal program before `DisjointSet`, kept as the baseline:
+ * interleaved {parent, rank} records with recursive path compression and union by rank.
+ */
+struct Subset {
+    int parent, rank;
+};
+
+int find(vector<Subset>& subsets, int i) {
+    if (subsets[i].parent != i) {
+        subsets[i].parent = find(subsets, subsets[i].parent);
+    }
+    return subsets[i].parent;
+}
+
+bool unionSubsets(vector<Subset>& subsets, int x, int y) {
+    int rootX = find(subsets, x);
+    int rootY = find(subsets, y);
+    if (rootX == rootY) return false;
+
+    if (subsets[rootX].rank < subsets[rootY].rank) {
+        subsets[rootX].parent = rootY;
+    } else if (subsets[rootX].rank > subsets[rootY].rank) {
+        subsets[rootY].parent = rootX;
+    } else {
+        subsets[rootY].parent = rootX;
+        subsets[rootX].rank++;
+    }
+    return true;
+}
+
+// One operation of the workload: a union if `isUnion`, otherwise a connectivity query
+struct Operation {
+    int x, y;
+    bool isUnion;
+};
+
+// Function to generate `count` random operations on n elements, a fraction `unionShare` of them unions
+vector<Operation> generateOperations(int n, long long count, double unionShare, uint64_t seed) {
+    bench::Random rng(seed);
+    vector<Operation> ops(count);
+    for (Operation& op : ops) {
+        op.x = rng.below(n);
+        op.y = rng.below(n);
+        op.isUnion = rng.unit() < unionShare;
+    }
+    return ops;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("disjoint_set", options);
+        int n = runner.scaled(1000000, 16);
+        long long count = 4LL * n;
+
+        for (double unionShare : {0.1, 0.5, 0.9}) {
+            vector<Operation> ops = generateOperations(n, count, unionShare, options.seed);
+            string suffix = bench::param("n", n) + bench::param("ops", count) + bench::param("unions", unionShare);
+
+            // Baseline: recursive find over interleaved {parent, rank}
+            uint64_t expected = runner.run("recursiveSubsets" + suffix, count, [&]() {
+                vector<Subset> subsets(n);
+                for (int v = 0; v < n; v++) subsets[v] = {v, 0};
+                uint64_t hits = 0;
+                for (const Operation& op : ops) {
+                    if (op.isUnion) hits += unionSubsets(subsets, op.x, op.y);
+                    else hits += find(subsets, op.x) == find(subsets, op.y);
+                }
+                return hits;
+            });
+
+            // DisjointSet: path halving, size packed into the parent word
+            uint64_t found = runner.run("DisjointSet" + suffix, count, [&]() {
+                DisjointSet sets(n);
+                uint64_t hits = 0;
+                for (const Operation& op : ops) {
+                    if (op.isUnion) hits += sets.unite(op.x, op.y);
+                    else hits += sets.connected(op.x, op.y);
+                }
+                return hits;
+            });
+            if (runner.selected("recursiveSubsets" + suffix) && runner.selected("DisjointSet" + suffix) &&
+                found != expected) {
+                throw runtime_error("DisjointSet" + suffix + " disagrees with the baseline");
+            }
+
+            // DisjointSet::uniteMany on the unions only, then all queries
+            runner.run("DisjointSet.uniteMany" + suffix, count, [&]() {
+                DisjointSet sets(n);
+                vector<pair<int, int>> unions;
+                for (const Operation& op : ops) {
+                    if (op.isUnion) unions.push_back({op.x, op.y});
+                }
+                uint64_t hits = sets.uniteMany(unions);
+                for (const Operation& op : ops) {
+                    if (!op.isUnion) hits += sets.connected(op.x, op.y);
+                }
+                return hits;
+            });
+
+            /*
+             * ConcurrentDisjointSet with 1, 2, 4, ... threads sharing the operations. The order of
+             * the operations changes between runs, so query answers may differ; the checksum is
+             * the number of successful unions, which only depends on the final sets.
+             */
+            uint64_t merges = 0;
+            bool merged = false; // Whether a thread count ran and set `merges`
+            for (int threads : bench::threadCounts(thread::hardware_concurrency())) {
+                vector<uint64_t> connected(threads);
+                string name = "ConcurrentDisjointSet" + suffix + bench::param("threads", threads);
+                uint64_t unions = runner.run(name, count,
+                                             []() {}, [&]() {
+                    ConcurrentDisjointSet sets(n);
+                    vector<uint64_t> united(threads, 0);
+                    vector<thread> workers;
+                    for (int t = 0; t < threads; t++) {
+                        workers.emplace_back([&, t]() {
+                            size_t begin = ops.size() * t / threads, end = ops.size() * (t + 1) / threads;
+                            uint64_t localUnited = 0, localConnected = 0;
+                            for (size_t i = begin; i < end; i++) {
+                                if (ops[i].isUnion) localUnited += sets.unite(ops[i].x, ops[i].y);
+                                else localConnected += sets.connected(ops[i].x, ops[i].y);
+                            }
+                            united[t] = localUnited;
+                            connected[t] = localConnected;
+                        });
+                    }
+                    for (thread& worker : workers) worker.join();
+                    uint64_t total = 0;
+                    for (uint64_t u : united) total += u;
+                    return total;
+                }, [&]() {
+                    uint64_t total = 0;
+                    for (uint64_t c : connected) total += c;
+                    runner.record("connected", total);
+                });
+                if (!runner.selected(name)) continue;
+                if (merged && unions != merges) {
+                    throw runtime_error("ConcurrentDisjointSet" + suffix + " merged a different number of sets");
+                }
+                merges = unions;
+                merged = true;
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Disjoint-Set Micro-Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures a random mix of unions and connectivity queries on the structures in
+ *    disjoint_set.h, against the recursive {parent, rank} layout the Kruskal program used before.
+ *
+ * Cases:
+ *  - 1000000 elements and 4 operations per element; the same operation sequence is replayed
+ *    on every structure at 10%, 50% and 90% unions.
+ *  - The checksum of the sequential structures counts successful unions plus positive
+ *    queries, and must agree between the baseline and `DisjointSet`.
+ *  - `uniteMany` applies all unions of the sequence as one batch. Random pairs have no locality
+ *    to recover, so this mainly shows the cost of the grouping pass; batches whose pairs cluster
+ *    by vertex (for example edges read in vertex order) benefit from it.
+ *  - `ConcurrentDisjointSet` runs at 1, 2, 4, ... threads up to the number of hardware threads.
+ *    With several threads the order of operations changes, so its checksum counts only the
+ *    successful unions, which must be the same at every thread count.
+ *  - ns_per_item is per operation.
+ *
+ * Extra fields:
+ *  - `connected`: Positive queries of the concurrent structure (may vary between runs).
+ *
+ * Usage:
+ *  - `--scale` multiplies the number of elements.
+ */
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include <stdexcept>
+#include "minimum_spanning_tree.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace mst;
+
+// An MST algorithm under test; `minDensity` skips it on sparser graphs (array-based Prim is O(V^2))
+struct Algorithm {
+    string name;
+    function<vector<Edge>(vector<Edge>&, int)> run;
+    double minDensity;
+};
+
+vector<Algorithm> makeAlgorithms() {
+    int threads = thread::hardware_concurrency();
+    return {
+        {"kruskal", [](vector<Edge>& edges, int V) { return kruskalMST(edges, V); }, 0},
+        {"filterKruskal", [](vector<Edge>& edges, int V) { return filterKruskalMST(edges, V); }, 0},
+        {"heapPrim", [](vector<Edge>& edges, int V) { return heapPrimMST(edges, V); }, 0},
+        {"arrayPrim", [](vector<Edge>& edges, int V) { return arrayPrimMST(edges, V); }, 0.01},
+        {"parallelBoruvka", [threads](vector<Edge>& edges, int V) { return parallelBoruvkaMST(edges, V, threads); }, 0},
+        {"auto", [](vector<Edge>& edges, int V) {
+             vector<Edge> tree;
+             autoMST(edges, V, tree);
+             return tree;
+         }, 0},
+    };
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("mst", options);
+        int V = runner.scaled(10000, 2);
+
+        for (double density : {0.0005, 0.005, 0.05}) {
+            // Uniform weights, and weights that grow with the larger endpoint (see densitySweepBenchmark)
+            for (bool filterResistant : {false, true}) {
+                vector<Edge> edges = bench::randomGraph<Edge>(V, density, options.seed, 0, 999999, true);
+                if (filterResistant) {
+                    for (Edge& edge : edges) edge.weight = max(edge.src, edge.dest) * 1000 + edge.weight % 1000;
+                }
+
+                uint64_t expected = 0;
+                bool measured = false; // Whether an algorithm ran and set `expected`
+                vector<Edge> work;
+                for (const Algorithm& algorithm : makeAlgorithms()) {
+                    if (density < algorithm.minDensity) continue;
+                    string name = algorithm.name + bench::param("V", V) + bench::param("density", density) +
+                                  bench::param("weights", string(filterResistant ? "filter-resistant" : "uniform"));
+                    uint64_t total = runner.run(name, edges.size(), [&]() { work = edges; }, [&]() {
+                        uint64_t weight = 0;
+                        for (const Edge& edge : algorithm.run(work, V)) weight += edge.weight;
+                        return weight;
+                    });
+
+                    // All algorithms that ran must agree on the total weight
+                    if (!runner.selected(name)) continue;
+                    if (measured && total != expected) {
+                        throw runtime_error(name + " disagrees on the MST weight");
+                    }
+                    expected = total;
+                    measured = true;
+                }
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Minimum Spanning Tree Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Tracks Kruskal, Filter-Kruskal, both Prims, parallel Boruvka and `autoMST`
+ *    (minimum_spanning_tree.h) between commits, in the format of benchmark_harness.h.
+ *
+ * Cases:
+ *  - Connected random graphs with V = 10000 at 0.05%, 0.5% and 5% of all vertex pairs
+ *    (about 25 thousand to 2.5 million edges). Array-based Prim only runs from 1% up.
+ *  - Uniform weights, which favour Filter-Kruskal, and filter-resistant weights, which make
+ *    it sort everything, as in the density sweep of the MST program.
+ *  - Each repetition gets a fresh copy of the edges (untimed), since Kruskal sorts them in place.
+ *  - The checksum is the MST weight; the program stops if two algorithms disagree on it.
+ *
+ * Usage:
+ *  - `--scale` multiplies V; `--filter kruskal` runs both Kruskal variants only.
+ */
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <stdexcept>
+#include "parallel_kmp.h"
+#include "benchmark_harness.h"
+using namespace std;
+using namespace kmp;
+
+// Function to time every mode of ParallelKMP for one pattern at 1, 2, 4, ... threads
+void benchmarkPattern(bench::Runner& runner, const string& name, const string& text, const string& pattern) {
+    for (int threads : bench::threadCounts(thread::hardware_concurrency())) {
+        ParallelKMP search(pattern, threads);
+        string suffix = bench::param("bytes", text.size()) + bench::param("threads", threads) +
+                        bench::param("pattern", name);
+
+        uint64_t counted = runner.run("count" + suffix, text.size(), [&]() {
+            return (uint64_t)search.count(text.data(), text.size());
+        });
+        uint64_t listed = runner.run("findAll" + suffix, text.size(), [&]() {
+            return (uint64_t)search.findAll(text.data(), text.size()).size();
+        });
+        runner.run("findFirst100" + suffix, text.size(), [&]() {
+            return (uint64_t)search.findFirst(text.data(), text.size(), 100).size();
+        });
+        if (runner.selected("count" + suffix) && runner.selected("findAll" + suffix) && counted != listed) {
+            throw runtime_error("findAll" + suffix + " disagrees with count");
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("parallel_kmp", options);
+        string text = bench::logText(runner.scaled(256 << 20, 1024), options.seed);
+
+        benchmarkPattern(runner, "rare", text, text.substr(text.size() / 2, 24));
+        benchmarkPattern(runner, "common", text, " INFO user=");
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Parallel KMP Search Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures how `ParallelKMP` (parallel_kmp.h) scales with the number of threads when
+ *    counting, listing, or finding the first 100 matches in a large text in memory.
+ *
+ * Cases:
+ *  - A 256 MB text of log lines from `logText`, searched for a "rare" pattern (24 bytes cut
+ *    from the middle of the text) and a "common" one (" INFO user=", on a quarter of the lines).
+ *  - Thread counts 1, 2, 4, ... up to the number of hardware threads.
+ *  - Each thread searches one chunk (plus m - 1 bytes of overlap) with the SIMD-prefiltered
+ *    KMP; chunk results are concatenated in order. The prefiltered scan reads several GB/s
+ *    per core, so a few threads are usually enough to reach the memory bandwidth; beyond
+ *    that, more threads add nothing.
+ *  - Finding the first 100 "common" matches stops almost immediately, so its ns_per_item is
+ *    very small.
+ *  - `count` and `findAll` must find the same number of matches.
+ *  - ns_per_item is per text byte.
+ *
+ * Usage:
+ *  - `--scale` multiplies the text size; `--filter threads=1/` keeps the single-thread cases.
+ */
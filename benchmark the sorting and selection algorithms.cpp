@@ -0,0 +1,213 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include "sort_counters.h"
+#include "randomized_quicksort.h"
+#include "randomized_select.h"
+#include "benchmark_harness.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+using namespace sort_counters;
+
+/*
+ * Hardware counters (cycles, branch misses, cache misses) read through perf_event_open.
+ * Counting covers the calling thread and threads it starts while enabled (the parallel
+ * sort's pool). If the kernel refuses the events (no PMU, perf_event_paranoid, containers),
+ * `available` is false and the values are reported as missing.
+ */
+class HardwareCounters {
+private:
+    static const int EVENTS = 3;
+    int fds[EVENTS];
+
+public:
+    bool available;
+
+    HardwareCounters() : available(false) {
+        for (int e = 0; e < EVENTS; e++) fds[e] = -1;
+#ifdef __linux__
+        const unsigned long long configs[EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+        available = true;
+        for (int e = 0; e < EVENTS; e++) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[e];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[e] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            if (fds[e] < 0) available = false;
+        }
+#endif
+    }
+
+    ~HardwareCounters() {
+#ifdef __linux__
+        for (int e = 0; e < EVENTS; e++) {
+            if (fds[e] >= 0) close(fds[e]);
+        }
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (!available) return;
+        for (int e = 0; e < EVENTS; e++) {
+            ioctl(fds[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Function to stop counting and fetch cycles, branch misses and cache misses
+    void stop(unsigned long long values[3]) {
+        for (int e = 0; e < EVENTS; e++) values[e] = 0;
+#ifdef __linux__
+        if (!available) return;
+        for (int e = 0; e < EVENTS; e++) {
+            ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[e], &values[e], sizeof(values[e])) != (ssize_t)sizeof(values[e])) {
+                values[e] = 0;
+            }
+        }
+#endif
+    }
+};
+
+/*
+ * An algorithm under test.
+ * Contains:
+ *  - `name`: Name used in the case names.
+ *  - `run`: Sorts the array, or for selection returns the selected element.
+ *  - `isSelect`: True for selection algorithms (checked against nth_element).
+ */
+struct Engine {
+    string name;
+    function<int(vector<int>&)> run;
+    bool isSelect;
+};
+
+vector<Engine> makeEngines() {
+    int threads = thread::hardware_concurrency();
+    return {
+        {"randomizedQuickSort", [](vector<int>& a) { quicksort::randomizedQuickSort(a, 0, (int)a.size() - 1); return 0; }, false},
+        {"sequentialQuickSort", [](vector<int>& a) { quicksort::sequentialQuickSort(a, 0, (int)a.size() - 1); return 0; }, false},
+        {"parallelQuickSort", [threads](vector<int>& a) { quicksort::parallelRandomizedQuickSort(a, threads, 1 << 14); return 0; }, false},
+        {"lsdRadixSort", [](vector<int>& a) { quicksort::lsdRadixSort<11>(a); return 0; }, false},
+        {"americanFlagSort", [](vector<int>& a) { quicksort::americanFlagSort(a); return 0; }, false},
+        {"autoSort", [](vector<int>& a) { quicksort::autoSort(a, false); return 0; }, false},
+        {"randomizedSelect", [](vector<int>& a) { return selection::randomizedSelect(a, 0, (int)a.size() - 1, ((int)a.size() + 1) / 2); }, true},
+    };
+}
+
+/*
+ * Function to run one engine on one input as a case of the runner. Each repetition sorts a
+ * fresh copy; the operation and hardware counters of the repetition are recorded as extra
+ * fields, and the result is checked (sorted output, or the same element as nth_element).
+ * The checksum is the selected element, or the middle element of the sorted array.
+ */
+void runEngine(bench::Runner& runner, const string& name, const Engine& engine, const vector<int>& input,
+               HardwareCounters& hardware) {
+    int n = input.size();
+    int expectedSelect = 0;
+    if (engine.isSelect) {
+        vector<int> copy = input;
+        nth_element(copy.begin(), copy.begin() + (n - 1) / 2, copy.end());
+        expectedSelect = copy[(n - 1) / 2];
+    }
+
+    vector<int> arr;
+    int selected = 0;
+    runner.run(name, n, [&]() {
+        arr = input;
+        resetCounters();
+        hardware.start();
+    }, [&]() {
+        selected = engine.run(arr);
+        return (uint64_t)(uint32_t)(engine.isSelect ? selected : arr[n / 2]);
+    }, [&]() {
+        unsigned long long hw[3];
+        hardware.stop(hw);
+        bool correct = engine.isSelect ? selected == expectedSelect : is_sorted(arr.begin(), arr.end());
+        if (!correct) {
+            throw runtime_error(name + ": wrong result");
+        }
+#ifndef NO_SORT_COUNTERS
+        OperationCounts counts = readCounters();
+        runner.record("comparisons", counts.comparisons);
+        runner.record("swaps", counts.swaps);
+        runner.record("max_depth", counts.maxDepth);
+#endif
+        if (hardware.available) {
+            runner.record("cycles", hw[0]);
+            runner.record("branch_misses", hw[1]);
+            runner.record("cache_misses", hw[2]);
+        }
+    });
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        bench::Options options = bench::parseOptions(argc, argv);
+        bench::Runner runner("sorting", options);
+        const vector<string> distributions = {"random", "sorted", "reversed", "organ-pipe", "few-unique", "zipf"};
+        vector<Engine> engines = makeEngines();
+        HardwareCounters hardware;
+
+        for (long long size : {1000, 10000, 100000}) {
+            int n = runner.scaled(size, 16);
+            for (const string& distribution : distributions) {
+                vector<int> input = bench::generateKeys(distribution, n, options.seed + n);
+                string suffix = bench::param("n", n) + bench::param("keys", distribution);
+                for (const Engine& engine : engines) {
+                    runEngine(runner, engine.name + suffix, engine, input, hardware);
+                }
+            }
+        }
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+/*
+ * Sorting and Selection Benchmark Explanation:
+ *
+ * Purpose:
+ *  - Measures `randomizedQuickSort`, `randomizedSelect` and the newer sort engines
+ *    (sequential, parallel, radix and automatic) on standard input distributions, through
+ *    the `Runner` of benchmark_harness.h like the other benchmarks.
+ *
+ * Cases:
+ *  - Arrays of 1000, 10000 and 100000 keys from `generateKeys`, seeded with the seed + n, in
+ *    the random, sorted, reversed, organ-pipe, few-unique and zipf distributions.
+ *  - Every repetition sorts a fresh copy of the input (copied outside the timing), and every
+ *    result is checked (sorted output, or the same element as `nth_element`).
+ *  - ns_per_item is per key.
+ *
+ * Extra fields:
+ *  - `comparisons`, `swaps`, `max_depth`: From `sort_counters.h`, the median over the
+ *    repetitions. Compiling with -DNO_SORT_COUNTERS removes the counters and these fields,
+ *    so timings can be taken without them.
+ *  - `cycles`, `branch_misses`, `cache_misses`: From perf_event_open, present only when the
+ *    kernel allows it.
+ *
+ * Usage:
+ *  - `--scale` multiplies the array sizes; `--filter` selects engines or inputs, e.g.
+ *    `--filter lsdRadixSort` or `--filter keys=zipf`.
+ */
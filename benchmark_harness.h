@@ -0,0 +1,746 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <new>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <random>
+#include <type_traits>
+#include <malloc.h>
+#include <sys/resource.h>
+
+/*
+ * Shared harness of the per-algorithm benchmarks.
+ * Contains:
+ *  - `Random`, `randomGraph`, `textCorpus`, `randomText`, `logText`, `generateKeys`: Seeded
+ *    input generators. They use only the raw output of std::mt19937_64 (no std distributions,
+ *    whose results differ between standard libraries), so the same seed gives the same input
+ *    everywhere.
+ *  - `threadCounts`: The thread counts of the scaling cases.
+ *  - `AllocationCounters`: Filled by the replacement global operator new/delete below.
+ *  - `resetPeakRss`, `peakRssKB`: The resident set high-water mark of the process.
+ *  - `Options`, `parseOptions`: The common command line of the benchmarks.
+ *  - `Runner`: Runs a case with warmup and repetitions and reports median/p99 time, heap
+ *    allocations, peak memory and any extra figures the benchmark records, as JSON lines
+ *    (one object per case) or as a table.
+ *  - `parseJsonLine`: Reads one of those lines back, for comparing two runs.
+ * The replacement operator new/delete must be defined once per program, so this header is
+ * included only by the benchmark's single source file.
+ */
+namespace bench {
+
+/*
+ * Counters of the replacement allocator.
+ * Contains:
+ *  - `allocations`, `bytes`: Calls to operator new and the bytes requested.
+ *  - `live`, `peak`: Usable bytes currently allocated and their maximum since the last reset.
+ * All threads update them, so a parallel algorithm is counted in full.
+ */
+struct AllocationCounters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> live;
+    std::atomic<uint64_t> peak;
+};
+
+inline AllocationCounters allocationCounters;
+
+// Function to account for one allocation of `requested` bytes that returned `p`
+inline void countAllocation(void* p, std::size_t requested) {
+    AllocationCounters& c = allocationCounters;
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+    c.bytes.fetch_add(requested, std::memory_order_relaxed);
+    uint64_t usable = malloc_usable_size(p);
+    uint64_t live = c.live.fetch_add(usable, std::memory_order_relaxed) + usable;
+    uint64_t peak = c.peak.load(std::memory_order_relaxed);
+    while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+// Function to account for freeing `p`
+inline void countFree(void* p) {
+    if (p != nullptr) {
+        allocationCounters.live.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    }
+}
+
+// Function to allocate with malloc (or posix_memalign for over-aligned types) and count it
+inline void* countedAllocate(std::size_t size, std::size_t alignment) {
+    if (size == 0) size = 1;
+    void* p = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        p = malloc(size);
+    } else if (posix_memalign(&p, alignment, size) != 0) {
+        p = nullptr;
+    }
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    countAllocation(p, size);
+    return p;
+}
+
+// Function to free memory from countedAllocate (not inlined into operator delete, where GCC
+// would take the free() for a mismatch with operator new)
+__attribute__((noinline)) inline void countedFree(void* p) {
+    countFree(p);
+    free(p);
+}
+
+/*
+ * Function to make the peak resident set size start again from the current size.
+ * Linux resets VmHWM when "5" is written to /proc/self/clear_refs; returns false where that
+ * is not supported, in which case `peakRssKB` keeps reporting the peak of the whole process.
+ */
+inline bool resetPeakRss() {
+    FILE* file = fopen("/proc/self/clear_refs", "w");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = fputs("5", file) >= 0;
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+// Function to get the peak resident set size in KB (VmHWM, or getrusage if /proc is missing)
+inline long peakRssKB() {
+    FILE* file = fopen("/proc/self/status", "r");
+    if (file != nullptr) {
+        char line[256];
+        long kb = -1;
+        while (fgets(line, sizeof(line), file) != nullptr) {
+            if (strncmp(line, "VmHWM:", 6) == 0) {
+                kb = strtol(line + 6, nullptr, 10);
+                break;
+            }
+        }
+        fclose(file);
+        if (kb >= 0) {
+            return kb;
+        }
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/*
+ * Deterministic random source.
+ * `next` is the raw 64-bit output of std::mt19937_64, which the standard fixes exactly;
+ * `below` and `unit` derive integers and doubles from it without std distributions.
+ */
+class Random {
+private:
+    std::mt19937_64 engine;
+
+public:
+    explicit Random(uint64_t seed) : engine(seed) {}
+
+    uint64_t next() {
+        return engine();
+    }
+
+    // Function to get an integer in 0 .. n-1 (n > 0)
+    uint64_t below(uint64_t n) {
+        return (uint64_t)(((unsigned __int128)engine() * n) >> 64);
+    }
+
+    // Function to get a double in [0, 1)
+    double unit() {
+        return (engine() >> 11) * 0x1.0p-53;
+    }
+};
+
+/*
+ * Function to generate a random weighted graph on V vertices.
+ * Parameters:
+ *  - density: Fraction of the V(V-1)/2 vertex pairs that get an edge, as in the MST program's
+ *    `graphDensity`. Dense graphs (>= 0.25) keep each pair with that probability; sparser ones
+ *    draw the endpoints of each edge at random.
+ *  - minWeight, maxWeight: Weights are uniform in this range.
+ *  - connected: First adds the edges of a random spanning path, so every vertex is reachable.
+ * Works for any edge struct with `src`, `dest` and `weight` members, in that order.
+ */
+template <typename Edge>
+std::vector<Edge> randomGraph(int V, double density, uint64_t seed, int minWeight, int maxWeight, bool connected) {
+    Random rng(seed);
+    uint64_t span = (uint64_t)((long long)maxWeight - minWeight + 1);
+    auto weight = [&]() { return (int)(minWeight + (long long)rng.below(span)); };
+
+    std::vector<Edge> edges;
+    if (connected && V > 1) {
+        std::vector<int> order(V);
+        std::iota(order.begin(), order.end(), 0);
+        for (int i = V - 1; i > 0; i--) {
+            std::swap(order[i], order[rng.below(i + 1)]);
+        }
+        for (int i = 0; i + 1 < V; i++) {
+            edges.push_back(Edge{order[i], order[i + 1], weight()});
+        }
+    }
+
+    if (density >= 0.25) {
+        for (int u = 0; u < V; u++) {
+            for (int v = u + 1; v < V; v++) {
+                if (rng.unit() < density) edges.push_back(rng.below(2) ? Edge{u, v, weight()} : Edge{v, u, weight()});
+            }
+        }
+    } else {
+        long long E = (long long)(density * V * (V - 1) / 2);
+        edges.reserve(edges.size() + E);
+        for (long long i = 0; i < E; i++) {
+            int u = (int)rng.below(V), v = (int)rng.below(V);
+            edges.push_back(Edge{u, v, weight()});
+        }
+    }
+    return edges;
+}
+
+/*
+ * Function to generate n characters of text from the first `alphabet` lowercase letters.
+ * `repetitiveness` is the fraction of the text copied from earlier in the text: at each step,
+ * with that probability, a run of 8 to 71 characters starting at a random earlier position is
+ * appended; otherwise one random letter. 0 gives independent letters; values near 1 give long
+ * repeats, like logs or versioned documents, which deepen suffix trees and lengthen partial
+ * pattern matches.
+ */
+inline std::string textCorpus(size_t n, int alphabet, double repetitiveness, uint64_t seed) {
+    Random rng(seed);
+    std::string text;
+    text.reserve(n);
+    while (text.size() < n) {
+        if (text.size() >= 64 && rng.unit() < repetitiveness) {
+            size_t length = std::min<size_t>(8 + rng.below(64), n - text.size());
+            size_t from = rng.below(text.size() - length + 1);
+            for (size_t i = 0; i < length; i++) {
+                text.push_back(text[from + i]);
+            }
+        } else {
+            text.push_back((char)('a' + rng.below(alphabet)));
+        }
+    }
+    return text;
+}
+
+// Function to generate n characters drawn uniformly from `letters`, e.g. "ACGT"
+inline std::string randomText(size_t n, const std::string& letters, Random& rng) {
+    std::string text(n, letters[0]);
+    for (char& c : text) {
+        c = letters[rng.below(letters.size())];
+    }
+    return text;
+}
+
+// Function to generate a lowercase word of minLength to maxLength letters
+inline std::string randomWord(Random& rng, int minLength, int maxLength) {
+    return randomText(minLength + rng.below(maxLength - minLength + 1), "abcdefghijklmnopqrstuvwxyz", rng);
+}
+
+/*
+ * Function to generate log lines totalling at least `bytes` bytes, such as
+ * "2024-05-01 12:34:56 INFO user=4711 " followed by 8 words from a vocabulary of 2000 random
+ * words of 3 to 10 letters. The fixed prefix and the level names recur on every line, which
+ * makes candidates frequent for patterns taken from them.
+ */
+inline std::string logText(size_t bytes, uint64_t seed) {
+    static const char* levels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+    Random rng(seed);
+    std::vector<std::string> vocabulary(2000);
+    for (std::string& word : vocabulary) {
+        word = randomWord(rng, 3, 10);
+    }
+    std::string text;
+    text.reserve(bytes + 256);
+    while (text.size() < bytes) {
+        text += "2024-05-01 12:" + std::to_string(10 + rng.below(50)) + ":" + std::to_string(10 + rng.below(50)) + " " +
+                levels[rng.below(4)] + " user=" + std::to_string(rng.below(100000));
+        for (int w = 0; w < 8; w++) {
+            text += " " + vocabulary[rng.below(vocabulary.size())];
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+/*
+ * Function to generate n int keys.
+ * Distributions: random, sorted, reversed, organ-pipe (ascending then descending),
+ * nearly-sorted (sorted, then 1% of the positions swapped at random), few-unique (16
+ * distinct values) and zipf (value k with probability proportional to 1/k).
+ * Throws invalid_argument for an unknown distribution.
+ */
+inline std::vector<int> generateKeys(const std::string& distribution, int n, uint64_t seed) {
+    Random rng(seed);
+    std::vector<int> keys(n);
+    if (distribution == "random") {
+        for (int& x : keys) x = (int)(uint32_t)rng.next();
+    } else if (distribution == "sorted") {
+        for (int i = 0; i < n; i++) keys[i] = i;
+    } else if (distribution == "reversed") {
+        for (int i = 0; i < n; i++) keys[i] = n - i;
+    } else if (distribution == "organ-pipe") {
+        for (int i = 0; i < n; i++) keys[i] = std::min(i, n - 1 - i);
+    } else if (distribution == "nearly-sorted") {
+        for (int i = 0; i < n; i++) keys[i] = i;
+        for (int s = 0; s < n / 100; s++) {
+            std::swap(keys[rng.below(n)], keys[rng.below(n)]);
+        }
+    } else if (distribution == "few-unique") {
+        for (int& x : keys) x = (int)rng.below(16);
+    } else if (distribution == "zipf") {
+        std::vector<double> cdf(n);
+        double sum = 0;
+        for (int k = 1; k <= n; k++) {
+            sum += 1.0 / k;
+            cdf[k - 1] = sum;
+        }
+        for (int& x : keys) {
+            x = (int)(std::lower_bound(cdf.begin(), cdf.end(), rng.unit() * sum) - cdf.begin()) + 1;
+        }
+    } else {
+        throw std::invalid_argument("unknown key distribution " + distribution);
+    }
+    return keys;
+}
+
+// Function to get the thread counts 1, 2, 4, ... up to `maximum` (at least 1)
+inline std::vector<int> threadCounts(int maximum) {
+    std::vector<int> counts;
+    for (int threads = 1; threads <= std::max(1, maximum); threads *= 2) {
+        counts.push_back(threads);
+    }
+    return counts;
+}
+
+// Function to format a case parameter as "/key=value" for case names
+template <typename T>
+std::string param(const char* key, T value) {
+    char buffer[64];
+    if constexpr (std::is_floating_point<T>::value) {
+        snprintf(buffer, sizeof(buffer), "/%s=%g", key, (double)value);
+    } else {
+        snprintf(buffer, sizeof(buffer), "/%s=%lld", key, (long long)value);
+    }
+    return buffer;
+}
+
+inline std::string param(const char* key, const std::string& value) {
+    return "/" + std::string(key) + "=" + value;
+}
+
+/*
+ * Options shared by the benchmarks.
+ * Contains:
+ *  - `warmup`, `repetitions`: Untimed and timed runs of every case.
+ *  - `seed`: Seed of the input generators.
+ *  - `scale`: Multiplies the default input sizes (e.g. 0.1 for a quick run).
+ *  - `filter`: Only cases whose name contains this text are run.
+ *  - `label`: Free text stored with every result, e.g. the commit being measured.
+ *  - `json`: JSON lines (default) or a table for reading.
+ *  - `output`: File the results are appended to, "-" for standard output.
+ */
+struct Options {
+    int warmup = 1;
+    int repetitions = 10;
+    uint64_t seed = 12345;
+    double scale = 1.0;
+    std::string filter;
+    std::string label;
+    bool json = true;
+    std::string output = "-";
+};
+
+// Function to parse the common benchmark options; throws invalid_argument with the usage
+inline Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    std::string usage = std::string("usage: ") + argv[0] +
+                        " [--warmup n] [--reps n] [--seed n] [--scale x] [--filter text] [--label text]"
+                        " [--format json|table] [--out file]";
+    for (int a = 1; a < argc; a += 2) {
+        std::string arg = argv[a];
+        if (a + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + arg + " (" + usage + ")");
+        }
+        std::string value = argv[a + 1];
+        if (arg == "--warmup") options.warmup = std::max(0, std::stoi(value));
+        else if (arg == "--reps") options.repetitions = std::max(1, std::stoi(value));
+        else if (arg == "--seed") options.seed = std::stoull(value);
+        else if (arg == "--scale") options.scale = std::stod(value);
+        else if (arg == "--filter") options.filter = value;
+        else if (arg == "--label") options.label = value;
+        else if (arg == "--out") options.output = value;
+        else if (arg == "--format" && (value == "json" || value == "table")) options.json = (value == "json");
+        else throw std::invalid_argument("unknown option " + arg + " " + value + " (" + usage + ")");
+    }
+    if (options.scale <= 0) {
+        throw std::invalid_argument("--scale must be positive");
+    }
+    return options;
+}
+
+// Function to escape a string for a JSON string literal
+inline std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/*
+ * Function to parse one line of `Runner` output: a flat JSON object whose values are strings,
+ * numbers or booleans. Returns the values as text, keyed by name; throws runtime_error if the
+ * line is not such an object.
+ */
+inline std::map<std::string, std::string> parseJsonLine(const std::string& line) {
+    std::map<std::string, std::string> fields;
+    size_t i = 0;
+    auto skipSpace = [&]() {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')) i++;
+    };
+    auto fail = [&]() -> std::runtime_error { return std::runtime_error("malformed result line: " + line); };
+    auto readString = [&]() {
+        if (i >= line.size() || line[i] != '"') throw fail();
+        std::string value;
+        for (i++; i < line.size() && line[i] != '"'; i++) {
+            if (line[i] == '\\' && i + 1 < line.size()) {
+                i++;
+                if (line[i] == 'u' && i + 4 < line.size()) {
+                    value += (char)std::stoi(line.substr(i + 1, 4), nullptr, 16);
+                    i += 4;
+                    continue;
+                }
+            }
+            value += line[i];
+        }
+        if (i >= line.size()) throw fail();
+        i++;
+        return value;
+    };
+
+    skipSpace();
+    if (i >= line.size() || line[i++] != '{') throw fail();
+    skipSpace();
+    while (i < line.size() && line[i] != '}') {
+        std::string key = readString();
+        skipSpace();
+        if (i >= line.size() || line[i++] != ':') throw fail();
+        skipSpace();
+        if (i < line.size() && line[i] == '"') {
+            fields[key] = readString();
+        } else {
+            size_t start = i;
+            while (i < line.size() && line[i] != ',' && line[i] != '}') i++;
+            std::string value = line.substr(start, i - start);
+            while (!value.empty() && value.back() == ' ') value.pop_back();
+            fields[key] = value;
+        }
+        skipSpace();
+        if (i < line.size() && line[i] == ',') {
+            i++;
+            skipSpace();
+        }
+    }
+    if (i >= line.size()) throw fail();
+    return fields;
+}
+
+/*
+ * Statistics of one case.
+ * Times are per repetition in nanoseconds; allocation figures are per repetition as well
+ * (the median over the repetitions). `peakHeapBytes` is the largest heap growth of a
+ * repetition over the heap in use before it; `peakRssKB` the process high-water mark.
+ * `extra` holds the figures recorded with `Runner::record`, each the median of its values.
+ */
+struct CaseResult {
+    std::string name;
+    double items;
+    double medianNs, p99Ns, minNs, meanNs;
+    uint64_t allocations, allocatedBytes, peakHeapBytes;
+    long peakRssKB;
+    uint64_t checksum;
+    std::vector<std::pair<std::string, double>> extra;
+};
+
+/*
+ * Runs the cases of one benchmark and writes their results.
+ * Every case runs `warmup` untimed and `repetitions` timed repetitions. `setup` prepares a
+ * fresh input before each repetition (e.g. a copy of the edges for an algorithm that sorts
+ * them) and is neither timed nor counted. `body` is the measured work and returns a checksum
+ * of its result, which must be the same in every repetition; it is written with the timings
+ * so that a change of result between two commits shows up next to a change of speed.
+ * `teardown` runs after each repetition, untimed, and may `record` figures of it (e.g.
+ * operation or hardware counters), which are written as extra fields of the case.
+ */
+class Runner {
+private:
+    std::string benchmark;
+    Options options;
+    FILE* out;
+    bool rssResettable;
+    bool recording;
+    std::vector<std::pair<std::string, std::vector<double>>> recorded;
+
+    // Function to get the nearest-rank percentile of sorted values
+    static double percentile(const std::vector<double>& sorted, double p) {
+        size_t rank = (size_t)std::ceil(p * sorted.size());
+        return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+
+    template <typename T>
+    static T median(std::vector<T> values) {
+        std::sort(values.begin(), values.end());
+        return values[(values.size() - 1) / 2];
+    }
+
+    void write(const CaseResult& r) {
+        if (options.json) {
+            fprintf(out,
+                    "{\"type\": \"case\", \"benchmark\": \"%s\", \"case\": \"%s\", \"label\": \"%s\", \"items\": %.0f, "
+                    "\"reps\": %d, \"median_ns\": %.0f, \"p99_ns\": %.0f, \"min_ns\": %.0f, \"mean_ns\": %.0f, "
+                    "\"ns_per_item\": %.3f, \"allocations\": %llu, \"allocated_bytes\": %llu, \"peak_heap_bytes\": %llu, "
+                    "\"peak_rss_kb\": %ld, \"checksum\": \"%016llx\"",
+                    jsonEscape(benchmark).c_str(), jsonEscape(r.name).c_str(), jsonEscape(options.label).c_str(), r.items,
+                    options.repetitions, r.medianNs, r.p99Ns, r.minNs, r.meanNs, r.items > 0 ? r.medianNs / r.items : 0.0,
+                    (unsigned long long)r.allocations, (unsigned long long)r.allocatedBytes,
+                    (unsigned long long)r.peakHeapBytes, r.peakRssKB, (unsigned long long)r.checksum);
+            for (const std::pair<std::string, double>& field : r.extra) {
+                fprintf(out, ", \"%s\": %.15g", jsonEscape(field.first).c_str(), field.second);
+            }
+            fprintf(out, "}\n");
+        } else {
+            fprintf(out, "%-64s %12.3f %12.3f %10.2f %12llu %12.2f %10.1f", r.name.c_str(), r.medianNs / 1e6,
+                    r.p99Ns / 1e6, r.items > 0 ? r.medianNs / r.items : 0.0, (unsigned long long)r.allocations,
+                    r.peakHeapBytes / 1048576.0, r.peakRssKB / 1024.0);
+            for (const std::pair<std::string, double>& field : r.extra) {
+                fprintf(out, "  %s=%.15g", field.first.c_str(), field.second);
+            }
+            fprintf(out, "\n");
+        }
+        fflush(out);
+    }
+
+public:
+    Runner(const std::string& benchmark, const Options& options)
+        : benchmark(benchmark), options(options), recording(false) {
+        out = options.output == "-" ? stdout : fopen(options.output.c_str(), "a");
+        if (out == nullptr) {
+            throw std::runtime_error("cannot open " + options.output);
+        }
+        rssResettable = resetPeakRss();
+        if (options.json) {
+            fprintf(out,
+                    "{\"type\": \"meta\", \"benchmark\": \"%s\", \"label\": \"%s\", \"seed\": %llu, \"scale\": %g, "
+                    "\"warmup\": %d, \"reps\": %d, \"compiler\": \"%s\", \"peak_rss_scope\": \"%s\"}\n",
+                    jsonEscape(benchmark).c_str(), jsonEscape(options.label).c_str(), (unsigned long long)options.seed,
+                    options.scale, options.warmup, options.repetitions, jsonEscape(__VERSION__).c_str(),
+                    rssResettable ? "case" : "process");
+        } else {
+            fprintf(out, "%s (seed %llu, scale %g, %d+%d runs)\n", benchmark.c_str(), (unsigned long long)options.seed,
+                    options.scale, options.warmup, options.repetitions);
+            fprintf(out, "%-64s %12s %12s %10s %12s %12s %10s\n", "Case", "Median ms", "p99 ms", "ns/item",
+                    "Allocs", "Heap MB", "RSS MB");
+        }
+        fflush(out);
+    }
+
+    ~Runner() {
+        if (out != stdout) fclose(out);
+    }
+
+    Runner(const Runner&) = delete;
+    Runner& operator=(const Runner&) = delete;
+
+    // Function to get the options, e.g. the seed and the scale for the input sizes
+    const Options& config() const {
+        return options;
+    }
+
+    // Function to scale a default input size by --scale (at least `minimum`)
+    long long scaled(long long size, long long minimum = 1) const {
+        return std::max(minimum, (long long)(size * options.scale));
+    }
+
+    // Function to check whether a case is selected by --filter
+    bool selected(const std::string& name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    /*
+     * Function to record a figure of the current repetition as an extra field of the case, e.g.
+     * from its teardown; the median over the repetitions is written. Ignored during warmup.
+     */
+    void record(const std::string& key, double value) {
+        if (!recording) {
+            return;
+        }
+        for (std::pair<std::string, std::vector<double>>& field : recorded) {
+            if (field.first == key) {
+                field.second.push_back(value);
+                return;
+            }
+        }
+        recorded.push_back(std::make_pair(key, std::vector<double>(1, value)));
+    }
+
+    /*
+     * Function to run one case (see the class comment). `items` is the input size that
+     * ns_per_item refers to. Returns the checksum, or 0 if the case is filtered out.
+     * Throws runtime_error if the checksum changes between repetitions.
+     */
+    template <typename Setup, typename Body, typename Teardown>
+    uint64_t run(const std::string& name, double items, Setup setup, Body body, Teardown teardown) {
+        if (!selected(name)) {
+            return 0;
+        }
+        for (int w = 0; w < options.warmup; w++) {
+            setup();
+            body();
+            teardown();
+        }
+
+        AllocationCounters& c = allocationCounters;
+        std::vector<double> times;
+        std::vector<uint64_t> allocations, bytes, peaks;
+        times.reserve(options.repetitions);
+        allocations.reserve(options.repetitions);
+        bytes.reserve(options.repetitions);
+        peaks.reserve(options.repetitions);
+        uint64_t checksum = 0;
+        if (rssResettable) resetPeakRss();
+        for (int r = 0; r < options.repetitions; r++) {
+            setup();
+            uint64_t liveBefore = c.live.load();
+            c.peak.store(liveBefore);
+            uint64_t allocationsBefore = c.allocations.load(), bytesBefore = c.bytes.load();
+
+            auto start = std::chrono::steady_clock::now();
+            uint64_t result = body();
+            times.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+
+            allocations.push_back(c.allocations.load() - allocationsBefore);
+            bytes.push_back(c.bytes.load() - bytesBefore);
+            peaks.push_back(c.peak.load() - liveBefore);
+            if (r > 0 && result != checksum) {
+                throw std::runtime_error(benchmark + " " + name + ": the result differs between repetitions");
+            }
+            checksum = result;
+
+            recording = true;
+            teardown();
+            recording = false;
+        }
+
+        std::vector<double> sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+        CaseResult result;
+        result.name = name;
+        result.items = items;
+        result.medianNs = median(times);
+        result.p99Ns = percentile(sorted, 0.99);
+        result.minNs = sorted.front();
+        result.meanNs = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        result.allocations = median(allocations);
+        result.allocatedBytes = median(bytes);
+        result.peakHeapBytes = *std::max_element(peaks.begin(), peaks.end());
+        result.peakRssKB = peakRssKB();
+        result.checksum = checksum;
+        for (const std::pair<std::string, std::vector<double>>& field : recorded) {
+            result.extra.push_back(std::make_pair(field.first, median(field.second)));
+        }
+        recorded.clear();
+        write(result);
+        return checksum;
+    }
+
+    // Function to run a case whose repetitions need no teardown
+    template <typename Setup, typename Body>
+    uint64_t run(const std::string& name, double items, Setup setup, Body body) {
+        return run(name, items, setup, body, []() {});
+    }
+
+    // Function to run a case that needs no fresh input per repetition
+    template <typename Body>
+    uint64_t run(const std::string& name, double items, Body body) {
+        return run(name, items, []() {}, body, []() {});
+    }
+};
+
+} // namespace bench
+
+/*
+ * Replacement global allocation functions: every operator new and delete of the program goes
+ * through the counters above. The array, nothrow and sized forms not listed here forward to
+ * these by default.
+ */
+void* operator new(std::size_t size) {
+    return bench::countedAllocate(size, 0);
+}
+
+void* operator new[](std::size_t size) {
+    return bench::countedAllocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return bench::countedAllocate(size, (std::size_t)alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return bench::countedAllocate(size, (std::size_t)alignment);
+}
+
+void operator delete(void* p) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    bench::countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    bench::countedFree(p);
+}
+
+#endif
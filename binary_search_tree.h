@@ -0,0 +1,100 @@
+#ifndef BINARY_SEARCH_TREE_H
+#define BINARY_SEARCH_TREE_H
+
+#include <vector>
+
+/*
+ * Binary search tree of distinct int values.
+ * Contains:
+ *  - `Node`: A value and its two subtrees.
+ *  - `BinarySearchTree`: Insert and search.
+ * Both operations walk down the tree in a loop rather than by recursion, so an unbalanced
+ * tree (e.g. after inserting sorted values) cannot overflow the call stack.
+ */
+namespace bst {
+
+/*
+ * Node structure for the Binary Search Tree (BST).
+ * Contains:
+ *  - `data`: The value stored in the node.
+ *  - `left`: Pointer to the left child.
+ *  - `right`: Pointer to the right child.
+ */
+struct Node {
+    int data;
+    Node* left;
+    Node* right;
+
+    // Constructor to initialize a new node
+    Node(int value) {
+        data = value;
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+/*
+ * Class representing the Binary Search Tree.
+ * Contains:
+ *  - `insert`: Function to insert a new node.
+ *  - `search`: Function to search for a value in the tree.
+ */
+class BinarySearchTree {
+private:
+    Node* root; // Root node of the tree
+
+public:
+    // Constructor to initialize the tree
+    BinarySearchTree() {
+        root = nullptr;
+    }
+
+    // Destructor: frees every node
+    ~BinarySearchTree() {
+        std::vector<Node*> stack;
+        if (root != nullptr) {
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            if (node->left != nullptr) stack.push_back(node->left);
+            if (node->right != nullptr) stack.push_back(node->right);
+            delete node;
+        }
+    }
+
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+    // Public function to insert a value (a value already in the tree is not added again)
+    void insert(int value) {
+        Node** link = &root;
+        while (*link != nullptr) {
+            if (value < (*link)->data) {
+                link = &(*link)->left; // Continue in the left subtree
+            } else if (value > (*link)->data) {
+                link = &(*link)->right; // Continue in the right subtree
+            } else {
+                return;
+            }
+        }
+        *link = new Node(value); // Create a new node where the search fell off the tree
+    }
+
+    // Public function to search for a value
+    bool search(int value) const {
+        Node* node = root;
+        while (node != nullptr) {
+            if (node->data == value) {
+                return true; // Value found
+            }
+            node = (value < node->data) ? node->left : node->right;
+        }
+        return false; // Value not found
+    }
+};
+
+} // namespace bst
+
+#endif
@@ -0,0 +1,1050 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+/*
+ * In-memory B-Tree and B+ Tree of int keys.
+ * Contains:
+ *  - `BTreeNode`, `BTree`: B-Tree with insert, search, remove, bulk loading and an append
+ *    fast path for ascending keys.
+ *  - `BPlusNode`, `BPlusTree`: B+ Tree mapping keys to values, with linked leaves for range scans.
+ * `traverse` writes the keys in order to any stream-like object with `operator<<`.
+ */
+namespace btree {
+
+
+/*
+ * A B-Tree node structure.
+ * Contains:
+ *  - `keys`: Array of keys in the node.
+ *  - `t`: Minimum degree of the B-Tree (defines the range for the number of keys).
+ *  - `children`: Array of child pointers.
+ *  - `n`: Current number of keys in the node.
+ *  - `leaf`: Boolean to indicate if the node is a leaf.
+ */
+class BTreeNode {
+public:
+    int* keys;          // Array of keys
+    int t;              // Minimum degree
+    BTreeNode** children; // Array of child pointers
+    int n;              // Current number of keys
+    bool leaf;          // True if the node is a leaf
+
+    // Constructor for BTreeNode
+    BTreeNode(int _t, bool _leaf);
+
+    // Destructor: frees the key and child arrays (not the children themselves)
+    ~BTreeNode();
+
+    // Function to write all keys of the subtree rooted at this node to `out` in order
+    template <typename Out>
+    void traverse(Out& out);
+
+    // Function to search for key k in the subtree rooted at this node
+    BTreeNode* search(int k);
+
+    // Function to find the index of the first key greater than or equal to k
+    int findKey(int k);
+
+    // Function to remove key k from the subtree rooted at this node
+    bool remove(int k);
+
+    // Functions used by remove
+    void removeFromLeaf(int idx);
+    void removeFromNonLeaf(int idx);
+    int getPredecessor(int idx);
+    int getSuccessor(int idx);
+    void fill(int idx);
+    void borrowFromPrev(int idx);
+    void borrowFromNext(int idx);
+    void merge(int idx);
+
+    // Function to insert a new key in a non-full node
+    void insertNonFull(int k);
+
+    // Function to split the child of this node
+    void splitChild(int i, BTreeNode* y);
+
+    // Friend class for accessing private members
+    friend class BTree;
+};
+
+// Share of the keys a full node on the right edge keeps when an appended key splits it
+const double APPEND_SPLIT_LEFT_SHARE = 0.9;
+
+/*
+ * A B-Tree class.
+ * Contains:
+ *  - Root node.
+ *  - Minimum degree (t).
+ *  - `rightSpine`: Cursor for appends: the path from the root to the rightmost leaf
+ *    (empty when it has to be recomputed).
+ *  - `maxKey`: The largest key, while `maxKeyValid` is true.
+ * Keys that are not smaller than every key in the tree take the append path: they are written
+ * straight into the rightmost leaf, and full nodes on the right edge are split 90/10 instead
+ * of 50/50, since no key will ever be inserted to their left again in a monotonic load. Nodes
+ * on the right edge may therefore hold fewer than t-1 keys until later appends fill them;
+ * search, insert and remove do not depend on that minimum.
+ */
+class BTree {
+private:
+    BTreeNode* root; // Pointer to the root node
+    int t;           // Minimum degree
+    std::vector<BTreeNode*> rightSpine;
+    int maxKey;
+    bool maxKeyValid;
+
+    // Function to (re)compute the path from the root to the rightmost leaf
+    void findRightSpine() {
+        rightSpine.clear();
+        for (BTreeNode* node = root; node != nullptr; node = node->leaf ? nullptr : node->children[node->n]) {
+            rightSpine.push_back(node);
+        }
+    }
+
+    // Function to get the largest key in the tree (the tree must not be empty)
+    int largestKey() {
+        if (!maxKeyValid) {
+            BTreeNode* node = root;
+            while (!node->leaf) {
+                node = node->children[node->n];
+            }
+            maxKey = node->keys[node->n - 1];
+            maxKeyValid = true;
+        }
+        return maxKey;
+    }
+
+    void appendKey(int k);
+    void splitRightmostChild(BTreeNode* parent);
+
+    // Function to free every node of a subtree
+    void destroy(BTreeNode* node) {
+        if (node == nullptr) {
+            return;
+        }
+        if (!node->leaf) {
+            for (int i = 0; i <= node->n; i++) {
+                destroy(node->children[i]);
+            }
+        }
+        delete node;
+    }
+
+public:
+    // Constructor for BTree
+    BTree(int _t) {
+        root = nullptr;
+        t = _t;
+        maxKeyValid = false;
+    }
+
+    // Destructor for BTree
+    ~BTree() {
+        destroy(root);
+    }
+
+    // Function to write all keys to `out` in order
+    template <typename Out>
+    void traverse(Out& out) {
+        if (root != nullptr) {
+            root->traverse(out);
+        }
+    }
+
+    // Function to search for a key; returns the node containing it or nullptr
+    BTreeNode* search(int k) {
+        return (root == nullptr) ? nullptr : root->search(k);
+    }
+
+    // Function to insert a new key
+    void insert(int k);
+
+    // Function to remove one occurrence of a key; returns false if it is not in the tree
+    bool remove(int k);
+
+    // Function to replace the contents with sorted keys, filling nodes to `fillFactor` of capacity
+    void bulkLoad(const std::vector<int>& sorted, double fillFactor = 1.0);
+
+    // Function to get the memory used by all nodes, in bytes
+    long long memoryUsage();
+};
+
+// Constructor for BTreeNode
+inline BTreeNode::BTreeNode(int _t, bool _leaf) {
+    t = _t;
+    leaf = _leaf;
+
+    keys = new int[2 * t - 1];         // Allocate memory for keys
+    children = new BTreeNode*[2 * t]; // Allocate memory for child pointers
+    n = 0;                            // Initialize the number of keys as 0
+}
+
+// Destructor for BTreeNode
+inline BTreeNode::~BTreeNode() {
+    delete[] keys;
+    delete[] children;
+}
+
+// Function to traverse all nodes in a subtree
+template <typename Out>
+void BTreeNode::traverse(Out& out) {
+    int i;
+    for (i = 0; i < n; i++) {
+        if (!leaf) {
+            children[i]->traverse(out); // Recursively visit child nodes
+        }
+        out << keys[i] << " "; // Print the key
+    }
+
+    if (!leaf) {
+        children[i]->traverse(out); // Visit the last child
+    }
+}
+
+// Function to insert a new key in the B-Tree
+inline void BTree::insert(int k) {
+    if (root == nullptr) {
+        root = new BTreeNode(t, true); // Create a new root
+        root->keys[0] = k;            // Insert the key into the root
+        root->n = 1;                  // Update the number of keys
+        maxKey = k;
+        maxKeyValid = true;
+        rightSpine.clear();
+    } else if (k >= largestKey()) {
+        appendKey(k); // Fast path: the key goes to the end
+    } else {
+        rightSpine.clear(); // Splits below may change the right edge
+        if (root->n == 2 * t - 1) { // Root is full
+            BTreeNode* newRoot = new BTreeNode(t, false); // Create a new root
+            newRoot->children[0] = root;                 // Make old root a child
+
+            newRoot->splitChild(0, root); // Split the old root
+
+            int i = (newRoot->keys[0] < k) ? 1 : 0; // Determine which subtree to go to
+            newRoot->children[i]->insertNonFull(k); // Insert in the appropriate subtree
+
+            root = newRoot; // Update root
+        } else {
+            root->insertNonFull(k); // Insert in the non-full root
+        }
+    }
+}
+
+// Function to insert a key in a non-full node
+inline void BTreeNode::insertNonFull(int k) {
+    int i = n - 1; // Index of the rightmost key
+
+    if (leaf) {
+        while (i >= 0 && keys[i] > k) { // Find location for new key
+            keys[i + 1] = keys[i]; // Shift keys to make space
+            i--;
+        }
+
+        keys[i + 1] = k; // Insert the new key
+        n++;             // Update the number of keys
+    } else {
+        while (i >= 0 && keys[i] > k) {
+            i--; // Find child to descend
+        }
+
+        if (children[i + 1]->n == 2 * t - 1) { // Child is full
+            splitChild(i + 1, children[i + 1]); // Split the child
+
+            if (keys[i + 1] < k) {
+                i++;
+            }
+        }
+        children[i + 1]->insertNonFull(k); // Recur for the appropriate child
+    }
+}
+
+// Function to split a full child
+inline void BTreeNode::splitChild(int i, BTreeNode* y) {
+    BTreeNode* z = new BTreeNode(y->t, y->leaf); // Create a new node
+    z->n = t - 1;                               // Update the number of keys in the new node
+
+    for (int j = 0; j < t - 1; j++) {
+        z->keys[j] = y->keys[j + t]; // Move the last (t-1) keys to the new node
+    }
+
+    if (!y->leaf) {
+        for (int j = 0; j < t; j++) {
+            z->children[j] = y->children[j + t]; // Move the child pointers
+        }
+    }
+
+    y->n = t - 1; // Update the number of keys in the old node
+
+    for (int j = n; j >= i + 1; j--) {
+        children[j + 1] = children[j]; // Shift children to make space
+    }
+
+    children[i + 1] = z; // Link the new child
+
+    for (int j = n - 1; j >= i; j--) {
+        keys[j + 1] = keys[j]; // Shift keys to make space
+    }
+
+    keys[i] = y->keys[t - 1]; // Move a key from the old node to the parent
+    n++;                      // Increment the number of keys
+}
+
+// Function to search for key k in the subtree rooted at this node
+inline BTreeNode* BTreeNode::search(int k) {
+    int i = findKey(k);
+
+    if (i < n && keys[i] == k) {
+        return this; // Key found in this node
+    }
+
+    if (leaf) {
+        return nullptr; // Key is not present
+    }
+
+    return children[i]->search(k); // Go to the appropriate child
+}
+
+// Function to find the index of the first key greater than or equal to k
+inline int BTreeNode::findKey(int k) {
+    int idx = 0;
+    while (idx < n && keys[idx] < k) {
+        idx++;
+    }
+    return idx;
+}
+
+// Function to remove one occurrence of a key from the B-Tree
+inline bool BTree::remove(int k) {
+    if (root == nullptr) {
+        return false;
+    }
+
+    bool removed = root->remove(k);
+    rightSpine.clear();
+    maxKeyValid = false;
+
+    // If the root has no keys left, its only child (if any) becomes the new root
+    if (root->n == 0) {
+        BTreeNode* oldRoot = root;
+        root = root->leaf ? nullptr : root->children[0];
+        delete oldRoot;
+    }
+    return removed;
+}
+
+/*
+ * Function to append a key that is not smaller than any key in the tree.
+ * The rightmost leaf is reached through the cached right spine instead of a search. If it is
+ * full, the lowest spine node with room is found, and every full node below it is split with
+ * `splitRightmostChild`, from the top down, so each split has room in its parent.
+ * Amortized O(1) per key for a monotonic sequence of keys.
+ */
+inline void BTree::appendKey(int k) {
+    if (rightSpine.empty()) {
+        findRightSpine();
+    }
+
+    int h = rightSpine.size() - 1;
+    while (h >= 0 && rightSpine[h]->n == 2 * t - 1) {
+        h--;
+    }
+    if (h < 0) { // The whole right edge is full: the tree grows by one level
+        BTreeNode* newRoot = new BTreeNode(t, false);
+        newRoot->children[0] = root;
+        root = newRoot;
+        rightSpine.insert(rightSpine.begin(), newRoot);
+        h = 0;
+    }
+    for (int level = h; level + 1 < (int)rightSpine.size(); level++) {
+        splitRightmostChild(rightSpine[level]);
+        rightSpine[level + 1] = rightSpine[level]->children[rightSpine[level]->n];
+    }
+
+    BTreeNode* leaf = rightSpine.back();
+    leaf->keys[leaf->n++] = k;
+    maxKey = k;
+    maxKeyValid = true;
+}
+
+/*
+ * Function to split the full last child of `parent` 90/10: the child keeps
+ * APPEND_SPLIT_LEFT_SHARE of its keys, the next key moves up, and the rest (possibly none)
+ * moves to a new last child, which the following appends fill.
+ */
+inline void BTree::splitRightmostChild(BTreeNode* parent) {
+    BTreeNode* y = parent->children[parent->n];
+    BTreeNode* z = new BTreeNode(t, y->leaf);
+    int keep = (int)((2 * t - 1) * APPEND_SPLIT_LEFT_SHARE);
+    keep = std::max(t - 1, std::min(keep, 2 * t - 2));
+
+    z->n = y->n - keep - 1;
+    for (int j = 0; j < z->n; j++) {
+        z->keys[j] = y->keys[keep + 1 + j];
+    }
+    if (!y->leaf) {
+        for (int j = 0; j <= z->n; j++) {
+            z->children[j] = y->children[keep + 1 + j];
+        }
+    }
+    parent->keys[parent->n] = y->keys[keep];
+    parent->children[parent->n + 1] = z;
+    parent->n++;
+    y->n = keep;
+}
+
+/*
+ * Function to build the tree bottom-up from sorted keys.
+ * Each level is a run of keys: it is cut into nodes of about `fillFactor * (2t-1)` keys with
+ * one key between consecutive nodes, and those keys, in order, form the level above (whose
+ * nodes take the nodes below as children, left to right). This repeats until a level fits in
+ * a single node, the root. Node sizes within a level are made as even as possible and never
+ * drop below t-1, so the result is a valid B-Tree. O(n) time, no key is compared or shifted.
+ */
+inline void BTree::bulkLoad(const std::vector<int>& sorted, double fillFactor) {
+    if (!std::is_sorted(sorted.begin(), sorted.end())) {
+        throw std::invalid_argument("bulkLoad needs keys in ascending order");
+    }
+    destroy(root);
+    root = nullptr;
+    rightSpine.clear();
+    maxKeyValid = false;
+    if (sorted.empty()) {
+        return;
+    }
+
+    long long capacity = (long long)(fillFactor * (2 * t - 1));
+    capacity = std::max<long long>(t - 1, std::min<long long>(capacity, 2 * t - 1));
+    if (capacity < 1) {
+        capacity = 1;
+    }
+
+    std::vector<int> keys = sorted;
+    std::vector<BTreeNode*> children; // Nodes of the level below (empty for the leaf level)
+    while (true) {
+        long long n = keys.size();
+        // Nodes in this level: each holds `capacity` keys plus one separator after it
+        long long nodes = (n + 1 + capacity) / (capacity + 1);
+        while (nodes > 1 && n - (nodes - 1) < nodes * (t - 1)) {
+            nodes--; // Too few keys for that many nodes to hold t-1 each
+        }
+
+        std::vector<int> separators;
+        std::vector<BTreeNode*> level;
+        long long inNodes = n - (nodes - 1);
+        long long next = 0, child = 0;
+        for (long long i = 0; i < nodes; i++) {
+            BTreeNode* node = new BTreeNode(t, children.empty());
+            node->n = inNodes / nodes + (i < inNodes % nodes ? 1 : 0);
+            for (int j = 0; j < node->n; j++) {
+                node->keys[j] = keys[next++];
+            }
+            if (!node->leaf) {
+                for (int j = 0; j <= node->n; j++) {
+                    node->children[j] = children[child++];
+                }
+            }
+            if (i + 1 < nodes) {
+                separators.push_back(keys[next++]);
+            }
+            level.push_back(node);
+        }
+
+        if (nodes == 1) {
+            root = level[0];
+            return;
+        }
+        keys.swap(separators);
+        children.swap(level);
+    }
+}
+
+// Function to get the memory used by all nodes, in bytes
+inline long long BTree::memoryUsage() {
+    long long nodeBytes = sizeof(BTreeNode) + (2 * t - 1) * sizeof(int) + 2 * t * sizeof(BTreeNode*);
+    long long nodes = 0;
+    std::vector<BTreeNode*> stack;
+    if (root != nullptr) {
+        stack.push_back(root);
+    }
+    while (!stack.empty()) {
+        BTreeNode* node = stack.back();
+        stack.pop_back();
+        nodes++;
+        if (!node->leaf) {
+            for (int i = 0; i <= node->n; i++) {
+                stack.push_back(node->children[i]);
+            }
+        }
+    }
+    return nodes * nodeBytes;
+}
+
+/*
+ * Function to remove key k from the subtree rooted at this node.
+ * Before descending into a child, the child is given at least t keys (by borrowing from a
+ * sibling or merging with one), so a key can always be removed from it without underflow and
+ * the removal never has to walk back up the tree.
+ */
+inline bool BTreeNode::remove(int k) {
+    int idx = findKey(k);
+
+    if (idx < n && keys[idx] == k) {
+        // The key is in this node
+        if (leaf) {
+            removeFromLeaf(idx);
+        } else {
+            removeFromNonLeaf(idx);
+        }
+        return true;
+    }
+
+    if (leaf) {
+        return false; // The key is not in the tree
+    }
+
+    // The key can only be in the subtree rooted at children[idx]
+    bool lastChild = (idx == n);
+    if (children[idx]->n < t) {
+        fill(idx);
+    }
+
+    // If the last child was merged with its left sibling, the key is now in children[idx - 1]
+    if (lastChild && idx > n) {
+        return children[idx - 1]->remove(k);
+    }
+    return children[idx]->remove(k);
+}
+
+// Function to remove the key at idx from a leaf node
+inline void BTreeNode::removeFromLeaf(int idx) {
+    for (int i = idx + 1; i < n; i++) {
+        keys[i - 1] = keys[i]; // Shift the following keys left
+    }
+    n--;
+}
+
+// Function to remove the key at idx from an internal node
+inline void BTreeNode::removeFromNonLeaf(int idx) {
+    int k = keys[idx];
+
+    if (children[idx]->n >= t) {
+        // Replace the key by its predecessor and remove the predecessor from the left subtree
+        int pred = getPredecessor(idx);
+        keys[idx] = pred;
+        children[idx]->remove(pred);
+    } else if (children[idx + 1]->n >= t) {
+        // Replace the key by its successor and remove the successor from the right subtree
+        int succ = getSuccessor(idx);
+        keys[idx] = succ;
+        children[idx + 1]->remove(succ);
+    } else {
+        // Both children have t-1 keys: merge them around k and remove k from the result
+        merge(idx);
+        children[idx]->remove(k);
+    }
+}
+
+// Function to get the largest key in the subtree of children[idx]
+inline int BTreeNode::getPredecessor(int idx) {
+    BTreeNode* cur = children[idx];
+    while (!cur->leaf) {
+        cur = cur->children[cur->n];
+    }
+    return cur->keys[cur->n - 1];
+}
+
+// Function to get the smallest key in the subtree of children[idx + 1]
+inline int BTreeNode::getSuccessor(int idx) {
+    BTreeNode* cur = children[idx + 1];
+    while (!cur->leaf) {
+        cur = cur->children[0];
+    }
+    return cur->keys[0];
+}
+
+// Function to give children[idx], which has only t-1 keys, at least t keys
+inline void BTreeNode::fill(int idx) {
+    if (idx != 0 && children[idx - 1]->n >= t) {
+        borrowFromPrev(idx);
+    } else if (idx != n && children[idx + 1]->n >= t) {
+        borrowFromNext(idx);
+    } else if (idx != n) {
+        merge(idx);
+    } else {
+        merge(idx - 1);
+    }
+}
+
+// Function to move a key from children[idx - 1] through this node into children[idx]
+inline void BTreeNode::borrowFromPrev(int idx) {
+    BTreeNode* child = children[idx];
+    BTreeNode* sibling = children[idx - 1];
+
+    for (int i = child->n - 1; i >= 0; i--) {
+        child->keys[i + 1] = child->keys[i]; // Make room at the front
+    }
+    if (!child->leaf) {
+        for (int i = child->n; i >= 0; i--) {
+            child->children[i + 1] = child->children[i];
+        }
+        child->children[0] = sibling->children[sibling->n]; // Sibling's last child moves over
+    }
+
+    child->keys[0] = keys[idx - 1];            // Separator moves down
+    keys[idx - 1] = sibling->keys[sibling->n - 1]; // Sibling's last key moves up
+
+    child->n++;
+    sibling->n--;
+}
+
+// Function to move a key from children[idx + 1] through this node into children[idx]
+inline void BTreeNode::borrowFromNext(int idx) {
+    BTreeNode* child = children[idx];
+    BTreeNode* sibling = children[idx + 1];
+
+    child->keys[child->n] = keys[idx]; // Separator moves down
+    if (!child->leaf) {
+        child->children[child->n + 1] = sibling->children[0]; // Sibling's first child moves over
+    }
+    keys[idx] = sibling->keys[0]; // Sibling's first key moves up
+
+    for (int i = 1; i < sibling->n; i++) {
+        sibling->keys[i - 1] = sibling->keys[i];
+    }
+    if (!sibling->leaf) {
+        for (int i = 1; i <= sibling->n; i++) {
+            sibling->children[i - 1] = sibling->children[i];
+        }
+    }
+
+    child->n++;
+    sibling->n--;
+}
+
+// Function to merge children[idx + 1] and the separator keys[idx] into children[idx]
+inline void BTreeNode::merge(int idx) {
+    BTreeNode* child = children[idx];
+    BTreeNode* sibling = children[idx + 1];
+
+    child->keys[t - 1] = keys[idx]; // Separator moves down into the middle
+
+    for (int i = 0; i < sibling->n; i++) {
+        child->keys[i + t] = sibling->keys[i];
+    }
+    if (!child->leaf) {
+        for (int i = 0; i <= sibling->n; i++) {
+            child->children[i + t] = sibling->children[i];
+        }
+    }
+
+    for (int i = idx + 1; i < n; i++) {
+        keys[i - 1] = keys[i]; // Close the gap left by the separator
+    }
+    for (int i = idx + 2; i <= n; i++) {
+        children[i - 1] = children[i];
+    }
+
+    child->n += sibling->n + 1;
+    n--;
+
+    delete sibling;
+}
+
+/*
+ * A B+ Tree node structure.
+ * Contains:
+ *  - `keys`: Array of keys in the node. In an internal node keys[i] separates children[i]
+ *    (keys < keys[i]) from children[i + 1] (keys >= keys[i]).
+ *  - `values`: Array of values (leaves only); values[i] belongs to keys[i].
+ *  - `children`: Array of child pointers (internal nodes only).
+ *  - `next`: The next leaf in key order (leaves only), so a range is read by walking leaves.
+ *  - `n`: Current number of keys in the node.
+ *  - `leaf`: Boolean to indicate if the node is a leaf.
+ */
+class BPlusNode {
+public:
+    int* keys;
+    int* values;
+    BPlusNode** children;
+    BPlusNode* next;
+    int n;
+    bool leaf;
+
+    // Constructor: a node with room for 2t-1 keys
+    BPlusNode(int t, bool _leaf) {
+        leaf = _leaf;
+        n = 0;
+        next = nullptr;
+        keys = new int[2 * t - 1];
+        values = leaf ? new int[2 * t - 1] : nullptr;
+        children = leaf ? nullptr : new BPlusNode*[2 * t];
+    }
+
+    ~BPlusNode() {
+        delete[] keys;
+        delete[] values;
+        delete[] children;
+    }
+
+    // Function to find the child whose subtree may contain k (number of separators <= k)
+    int childIndex(int k) const {
+        int i = 0;
+        while (i < n && keys[i] <= k) {
+            i++;
+        }
+        return i;
+    }
+
+    // Function to find the index of the first key greater than or equal to k (leaves)
+    int lowerBound(int k) const {
+        int i = 0;
+        while (i < n && keys[i] < k) {
+            i++;
+        }
+        return i;
+    }
+};
+
+/*
+ * A B+ Tree class mapping int keys to int values.
+ * Contains:
+ *  - Root node.
+ *  - Minimum degree (t): every node except the root holds between t-1 and 2t-1 keys.
+ * All keys and values live in the leaves; internal nodes only hold copies of keys that route
+ * a search. The leaves are linked in key order, so `scan(lo, hi)` is a single descent to the
+ * leaf holding lo followed by a sequential walk along the leaf chain.
+ * Like `BTree`, full nodes are split on the way down during insertion and thin nodes are
+ * refilled on the way down during removal, so no operation walks back up the tree.
+ */
+class BPlusTree {
+private:
+    BPlusNode* root;
+    int t;
+
+    void splitChild(BPlusNode* parent, int i);
+    void fill(BPlusNode* parent, int i);
+    void destroy(BPlusNode* node);
+
+public:
+    // Constructor for BPlusTree
+    BPlusTree(int _t) {
+        root = nullptr;
+        t = _t;
+    }
+
+    ~BPlusTree() {
+        destroy(root);
+    }
+
+    // Function to look up a key; stores its value and returns true if it is present
+    bool search(int k, int& value) const;
+
+    // Function to insert a key with a value; an existing key gets the new value
+    void insert(int k, int value);
+
+    // Function to remove a key; returns false if it is not in the tree
+    bool remove(int k);
+
+    // Function to get all (key, value) pairs with lo <= key <= hi in key order
+    std::vector<std::pair<int, int>> scan(int lo, int hi) const;
+
+    // Function to write all keys to `out` in order by walking the leaf chain
+    template <typename Out>
+    void traverse(Out& out) const;
+};
+
+// Function to free every node of a subtree
+inline void BPlusTree::destroy(BPlusNode* node) {
+    if (node == nullptr) {
+        return;
+    }
+    if (!node->leaf) {
+        for (int i = 0; i <= node->n; i++) {
+            destroy(node->children[i]);
+        }
+    }
+    delete node;
+}
+
+// Function to look up a key
+inline bool BPlusTree::search(int k, int& value) const {
+    BPlusNode* cur = root;
+    if (cur == nullptr) {
+        return false;
+    }
+    while (!cur->leaf) {
+        cur = cur->children[cur->childIndex(k)];
+    }
+    int i = cur->lowerBound(k);
+    if (i < cur->n && cur->keys[i] == k) {
+        value = cur->values[i];
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Function to split the full child parent->children[i].
+ *  - Leaf: the upper t keys move to a new leaf linked after the old one, and the first of
+ *    them is copied up as the separator (it stays in the leaf, since leaves hold every key).
+ *  - Internal node: as in a B-Tree, the middle key moves up and the upper t-1 keys move over.
+ */
+inline void BPlusTree::splitChild(BPlusNode* parent, int i) {
+    BPlusNode* y = parent->children[i];
+    BPlusNode* z = new BPlusNode(t, y->leaf);
+    int separator;
+
+    if (y->leaf) {
+        z->n = t;
+        for (int j = 0; j < t; j++) {
+            z->keys[j] = y->keys[j + t - 1];
+            z->values[j] = y->values[j + t - 1];
+        }
+        y->n = t - 1;
+        z->next = y->next;
+        y->next = z;
+        separator = z->keys[0];
+    } else {
+        z->n = t - 1;
+        for (int j = 0; j < t - 1; j++) {
+            z->keys[j] = y->keys[j + t];
+        }
+        for (int j = 0; j < t; j++) {
+            z->children[j] = y->children[j + t];
+        }
+        y->n = t - 1;
+        separator = y->keys[t - 1];
+    }
+
+    for (int j = parent->n; j >= i + 1; j--) {
+        parent->children[j + 1] = parent->children[j];
+    }
+    parent->children[i + 1] = z;
+    for (int j = parent->n - 1; j >= i; j--) {
+        parent->keys[j + 1] = parent->keys[j];
+    }
+    parent->keys[i] = separator;
+    parent->n++;
+}
+
+// Function to insert a key with a value
+inline void BPlusTree::insert(int k, int value) {
+    if (root == nullptr) {
+        root = new BPlusNode(t, true);
+    }
+    if (root->n == 2 * t - 1) { // Root is full: the tree grows by one level
+        BPlusNode* newRoot = new BPlusNode(t, false);
+        newRoot->children[0] = root;
+        root = newRoot;
+        splitChild(root, 0);
+    }
+
+    BPlusNode* cur = root;
+    while (!cur->leaf) {
+        int i = cur->childIndex(k);
+        if (cur->children[i]->n == 2 * t - 1) {
+            splitChild(cur, i);
+            if (cur->keys[i] <= k) {
+                i++;
+            }
+        }
+        cur = cur->children[i];
+    }
+
+    int i = cur->lowerBound(k);
+    if (i < cur->n && cur->keys[i] == k) {
+        cur->values[i] = value; // Existing key: replace the value
+        return;
+    }
+    for (int j = cur->n - 1; j >= i; j--) {
+        cur->keys[j + 1] = cur->keys[j];
+        cur->values[j + 1] = cur->values[j];
+    }
+    cur->keys[i] = k;
+    cur->values[i] = value;
+    cur->n++;
+}
+
+/*
+ * Function to give parent->children[i], which has only t-1 keys, at least t keys.
+ * Leaves borrow a key directly from a sibling and refresh the separator; internal nodes rotate
+ * a key through the parent as in a B-Tree. If neither sibling can spare a key, the child is
+ * merged with one of them (leaves are simply concatenated and unlinked; internal nodes take
+ * the separator down between them).
+ */
+inline void BPlusTree::fill(BPlusNode* parent, int i) {
+    BPlusNode* child = parent->children[i];
+
+    if (i > 0 && parent->children[i - 1]->n >= t) {
+        BPlusNode* prev = parent->children[i - 1];
+        for (int j = child->n - 1; j >= 0; j--) {
+            child->keys[j + 1] = child->keys[j];
+        }
+        if (child->leaf) {
+            for (int j = child->n - 1; j >= 0; j--) {
+                child->values[j + 1] = child->values[j];
+            }
+            child->keys[0] = prev->keys[prev->n - 1];
+            child->values[0] = prev->values[prev->n - 1];
+            parent->keys[i - 1] = child->keys[0];
+        } else {
+            for (int j = child->n; j >= 0; j--) {
+                child->children[j + 1] = child->children[j];
+            }
+            child->children[0] = prev->children[prev->n];
+            child->keys[0] = parent->keys[i - 1];
+            parent->keys[i - 1] = prev->keys[prev->n - 1];
+        }
+        child->n++;
+        prev->n--;
+        return;
+    }
+
+    if (i < parent->n && parent->children[i + 1]->n >= t) {
+        BPlusNode* next = parent->children[i + 1];
+        if (child->leaf) {
+            child->keys[child->n] = next->keys[0];
+            child->values[child->n] = next->values[0];
+            for (int j = 1; j < next->n; j++) {
+                next->keys[j - 1] = next->keys[j];
+                next->values[j - 1] = next->values[j];
+            }
+            parent->keys[i] = next->keys[0];
+        } else {
+            child->keys[child->n] = parent->keys[i];
+            child->children[child->n + 1] = next->children[0];
+            parent->keys[i] = next->keys[0];
+            for (int j = 1; j < next->n; j++) {
+                next->keys[j - 1] = next->keys[j];
+            }
+            for (int j = 1; j <= next->n; j++) {
+                next->children[j - 1] = next->children[j];
+            }
+        }
+        child->n++;
+        next->n--;
+        return;
+    }
+
+    // Merge children[m] and children[m + 1]
+    int m = (i < parent->n) ? i : i - 1;
+    BPlusNode* left = parent->children[m];
+    BPlusNode* right = parent->children[m + 1];
+    if (left->leaf) {
+        for (int j = 0; j < right->n; j++) {
+            left->keys[left->n + j] = right->keys[j];
+            left->values[left->n + j] = right->values[j];
+        }
+        left->n += right->n;
+        left->next = right->next;
+    } else {
+        left->keys[left->n] = parent->keys[m];
+        for (int j = 0; j < right->n; j++) {
+            left->keys[left->n + 1 + j] = right->keys[j];
+        }
+        for (int j = 0; j <= right->n; j++) {
+            left->children[left->n + 1 + j] = right->children[j];
+        }
+        left->n += right->n + 1;
+    }
+    for (int j = m + 1; j < parent->n; j++) {
+        parent->keys[j - 1] = parent->keys[j];
+    }
+    for (int j = m + 2; j <= parent->n; j++) {
+        parent->children[j - 1] = parent->children[j];
+    }
+    parent->n--;
+    delete right;
+}
+
+// Function to remove a key
+inline bool BPlusTree::remove(int k) {
+    if (root == nullptr) {
+        return false;
+    }
+
+    BPlusNode* cur = root;
+    while (!cur->leaf) {
+        int i = cur->childIndex(k);
+        if (cur->children[i]->n < t) {
+            fill(cur, i);
+            i = cur->childIndex(k); // Separators may have moved
+        }
+        BPlusNode* child = cur->children[i];
+
+        // The root lost its last separator in a merge: the tree shrinks by one level
+        if (cur == root && cur->n == 0) {
+            root = child;
+            delete cur;
+        }
+        cur = child;
+    }
+
+    // A separator equal to k may remain in an internal node; it still routes correctly
+    int i = cur->lowerBound(k);
+    if (i == cur->n || cur->keys[i] != k) {
+        return false;
+    }
+    for (int j = i + 1; j < cur->n; j++) {
+        cur->keys[j - 1] = cur->keys[j];
+        cur->values[j - 1] = cur->values[j];
+    }
+    cur->n--;
+
+    if (root->leaf && root->n == 0) {
+        delete root;
+        root = nullptr;
+    }
+    return true;
+}
+
+// Function to get all (key, value) pairs with lo <= key <= hi
+inline std::vector<std::pair<int, int>> BPlusTree::scan(int lo, int hi) const {
+    std::vector<std::pair<int, int>> result;
+    BPlusNode* cur = root;
+    if (cur == nullptr || lo > hi) {
+        return result;
+    }
+    while (!cur->leaf) {
+        cur = cur->children[cur->childIndex(lo)];
+    }
+
+    int i = cur->lowerBound(lo);
+    while (cur != nullptr) {
+        for (; i < cur->n; i++) {
+            if (cur->keys[i] > hi) {
+                return result;
+            }
+            result.push_back({cur->keys[i], cur->values[i]});
+        }
+        cur = cur->next; // Continue with the next leaf
+        i = 0;
+    }
+    return result;
+}
+
+// Function to print all keys in order
+template <typename Out>
+void BPlusTree::traverse(Out& out) const {
+    BPlusNode* cur = root;
+    if (cur == nullptr) {
+        return;
+    }
+    while (!cur->leaf) {
+        cur = cur->children[0];
+    }
+    for (; cur != nullptr; cur = cur->next) {
+        for (int i = 0; i < cur->n; i++) {
+            out << cur->keys[i] << " ";
+        }
+    }
+}
+
+} // namespace btree
+
+#endif
@@ -0,0 +1,656 @@
+#ifndef BTREE_MAP_H
+#define BTREE_MAP_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/*
+ * Ordered key/value maps built as B+ Trees.
+ * Contains:
+ *  - `BTreeMap<K, V, Compare, Capacity>`: Generic B+ Tree. Nodes hold up to `Capacity` keys in
+ *    arrays; values live in the leaves, which are linked in key order.
+ *  - `StringBTreeMap<V, NodeBytes>`: B+ Tree for std::string keys with slotted nodes (below).
+ *    `BTreeMap<std::string, V>` (with the default std::less) is this layout when V is trivially
+ *    copyable; its nodes are 4 KB and `Capacity` does not apply, since the number of keys per
+ *    node depends on their length. Other values (e.g. std::string) use the generic layout.
+ * Both offer `insert` (which replaces the value of an existing key), `find`, `scan(lo, hi)`,
+ * `size` and `height`. Inserts propagate splits bottom-up; keys are never removed.
+ */
+namespace btree {
+
+// Whether BTreeMap<K, V, Compare> is the slotted string layout (values are stored as node bytes)
+template <typename K, typename V, typename Compare>
+struct UsesSlottedStrings
+    : std::integral_constant<bool, std::is_same<K, std::string>::value &&
+                                       std::is_same<Compare, std::less<std::string>>::value &&
+                                       std::is_trivially_copyable<V>::value> {};
+
+template <typename K, typename V, typename Compare = std::less<K>, int Capacity = 32,
+          bool Slotted = UsesSlottedStrings<K, V, Compare>::value>
+class BTreeMap {
+    static_assert(Capacity >= 4, "A node needs room for at least 4 keys");
+
+private:
+    // Nodes have one spare slot, so an insert can overflow a node before it is split
+    struct Node {
+        bool leaf;
+        int count;
+        K keys[Capacity + 1];
+
+        explicit Node(bool _leaf) : leaf(_leaf), count(0) {}
+    };
+
+    struct Leaf : Node {
+        V values[Capacity + 1];
+        Leaf* next;
+
+        Leaf() : Node(true), next(nullptr) {}
+    };
+
+    // children[i] holds the keys in [keys[i - 1], keys[i])
+    struct Inner : Node {
+        Node* children[Capacity + 2];
+
+        Inner() : Node(false) {}
+    };
+
+    Node* root;
+    size_t entries;
+    int levels;
+    size_t leaves, inners;
+    Compare less;
+
+    static void destroy(Node* node) {
+        if (node->leaf) {
+            delete (Leaf*)node;
+            return;
+        }
+        Inner* inner = (Inner*)node;
+        for (int i = 0; i <= inner->count; i++) {
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    // Function to find the index of the first key not less than k
+    int lowerBound(const Node* node, const K& k) const {
+        return std::lower_bound(node->keys, node->keys + node->count, k, less) - node->keys;
+    }
+
+    // Function to find the index of the first key greater than k
+    int upperBound(const Node* node, const K& k) const {
+        return std::upper_bound(node->keys, node->keys + node->count, k, less) - node->keys;
+    }
+
+    const Leaf* findLeaf(const K& k) const {
+        const Node* node = root;
+        while (!node->leaf) {
+            node = ((const Inner*)node)->children[upperBound(node, k)];
+        }
+        return (const Leaf*)node;
+    }
+
+    /*
+     * Function to insert into the subtree of `node`. Returns the new right sibling if `node`
+     * had to be split (with its first key in `separator`), otherwise nullptr.
+     */
+    Node* insertInto(Node* node, const K& k, const V& v, K& separator, bool& added) {
+        if (node->leaf) {
+            Leaf* leaf = (Leaf*)node;
+            int pos = lowerBound(leaf, k);
+            if (pos < leaf->count && !less(k, leaf->keys[pos])) {
+                leaf->values[pos] = v; // Existing key: replace the value
+                added = false;
+                return nullptr;
+            }
+            for (int i = leaf->count; i > pos; i--) {
+                leaf->keys[i] = leaf->keys[i - 1];
+                leaf->values[i] = leaf->values[i - 1];
+            }
+            leaf->keys[pos] = k;
+            leaf->values[pos] = v;
+            leaf->count++;
+            added = true;
+            if (leaf->count <= Capacity) {
+                return nullptr;
+            }
+
+            // Split: the upper half moves to a new leaf linked after this one
+            Leaf* right = new Leaf();
+            leaves++;
+            int keep = leaf->count / 2;
+            right->count = leaf->count - keep;
+            for (int i = 0; i < right->count; i++) {
+                right->keys[i] = leaf->keys[keep + i];
+                right->values[i] = leaf->values[keep + i];
+            }
+            leaf->count = keep;
+            right->next = leaf->next;
+            leaf->next = right;
+            separator = right->keys[0];
+            return right;
+        }
+
+        Inner* inner = (Inner*)node;
+        int i = upperBound(inner, k);
+        K childSeparator;
+        Node* newChild = insertInto(inner->children[i], k, v, childSeparator, added);
+        if (newChild == nullptr) {
+            return nullptr;
+        }
+        for (int j = inner->count; j > i; j--) {
+            inner->keys[j] = inner->keys[j - 1];
+            inner->children[j + 1] = inner->children[j];
+        }
+        inner->keys[i] = childSeparator;
+        inner->children[i + 1] = newChild;
+        inner->count++;
+        if (inner->count <= Capacity) {
+            return nullptr;
+        }
+
+        // Split: the middle key moves up
+        Inner* right = new Inner();
+        inners++;
+        int mid = inner->count / 2;
+        right->count = inner->count - mid - 1;
+        for (int j = 0; j < right->count; j++) {
+            right->keys[j] = inner->keys[mid + 1 + j];
+        }
+        for (int j = 0; j <= right->count; j++) {
+            right->children[j] = inner->children[mid + 1 + j];
+        }
+        separator = inner->keys[mid];
+        inner->count = mid;
+        return right;
+    }
+
+public:
+    explicit BTreeMap(const Compare& _less = Compare()) : root(new Leaf()), entries(0), levels(1), leaves(1), inners(0), less(_less) {}
+
+    ~BTreeMap() {
+        destroy(root);
+    }
+
+    BTreeMap(const BTreeMap&) = delete;
+    BTreeMap& operator=(const BTreeMap&) = delete;
+
+    // Function to insert a key with a value; returns false if the key existed (its value is replaced)
+    bool insert(const K& k, const V& v) {
+        K separator;
+        bool added = false;
+        Node* right = insertInto(root, k, v, separator, added);
+        if (right != nullptr) { // The root was split: the tree grows by one level
+            Inner* newRoot = new Inner();
+            inners++;
+            newRoot->count = 1;
+            newRoot->keys[0] = separator;
+            newRoot->children[0] = root;
+            newRoot->children[1] = right;
+            root = newRoot;
+            levels++;
+        }
+        entries += added;
+        return added;
+    }
+
+    // Function to look up a key; stores its value in `value` and returns whether it was found
+    bool find(const K& k, V& value) const {
+        const Leaf* leaf = findLeaf(k);
+        int pos = lowerBound(leaf, k);
+        if (pos < leaf->count && !less(k, leaf->keys[pos])) {
+            value = leaf->values[pos];
+            return true;
+        }
+        return false;
+    }
+
+    // Function to get all (key, value) pairs with lo <= key <= hi in key order
+    std::vector<std::pair<K, V>> scan(const K& lo, const K& hi) const {
+        std::vector<std::pair<K, V>> result;
+        const Leaf* leaf = findLeaf(lo);
+        for (int i = lowerBound(leaf, lo); leaf != nullptr; leaf = leaf->next, i = 0) {
+            for (; i < leaf->count; i++) {
+                if (less(hi, leaf->keys[i])) {
+                    return result;
+                }
+                result.push_back({leaf->keys[i], leaf->values[i]});
+            }
+        }
+        return result;
+    }
+
+    size_t size() const {
+        return entries;
+    }
+
+    // Function to get the number of levels (1 for a single leaf)
+    int height() const {
+        return levels;
+    }
+
+    // Function to get the memory used by the node objects, in bytes (not memory the keys own)
+    size_t memoryUsage() const {
+        return leaves * sizeof(Leaf) + inners * sizeof(Inner);
+    }
+};
+
+/*
+ * B+ Tree for string keys with slotted nodes.
+ * Every node is one block of `NodeBytes` bytes:
+ *  - A header: key count, prefix length, start of the heap, leaf flag, and a link (the next
+ *    leaf for leaves, the rightmost child for inner nodes).
+ *  - A slot array growing from the front: per key a 4-byte head, plus the offset and length of
+ *    the rest of the key. The head holds the first four bytes of the key after the node prefix,
+ *    big-endian and zero-padded, so comparing heads as integers orders keys correctly whenever
+ *    the heads differ. A binary search therefore mostly reads only the compact slot array and
+ *    touches key bytes only to break ties.
+ *  - A heap growing from the back: the node prefix, then per key its remaining bytes followed
+ *    by its payload (the value in a leaf, the child pointer in an inner node).
+ * Prefix truncation: the bytes shared by all keys of a node are stored once, and only the
+ * remainder of each key is kept. Separator shortening: when a leaf splits, the separator is
+ * the shortest prefix of the right half's first key that is still greater than the left
+ * half's last key. Short separators and stripped prefixes let an inner node hold many more
+ * keys than an array of std::string objects, so the tree has fewer levels.
+ * Values must be trivially copyable, since they are stored as bytes inside the node.
+ */
+template <typename V, int NodeBytes = 4096>
+class StringBTreeMap {
+    static_assert(std::is_trivially_copyable<V>::value, "Values are stored as bytes inside the nodes");
+    static_assert(NodeBytes >= 512 && NodeBytes <= 65536, "Node offsets are 16-bit");
+
+public:
+    // Longest key accepted, so that a split always leaves both halves room to spare
+    static const size_t MAX_KEY_LENGTH = NodeBytes / 4 - 32;
+
+private:
+    struct Slot {
+        uint32_t head;
+        uint16_t offset;
+        uint16_t length;
+    };
+
+    struct Node {
+        uint16_t count;
+        uint16_t prefixLength;
+        uint16_t heapStart;
+        bool leaf;
+        Node* link; // Leaf: the next leaf. Inner node: the rightmost child.
+        char data[NodeBytes - 16];
+    };
+
+    static const size_t DATA_BYTES = sizeof(Node::data);
+
+    // A key with its payload bytes, used while a node is rebuilt
+    typedef std::pair<std::string, std::string> Entry;
+
+    Node* root;
+    size_t entries;
+    int levels;
+    size_t nodes;
+
+    static size_t payloadSize(const Node* node) {
+        return node->leaf ? sizeof(V) : sizeof(Node*);
+    }
+
+    static Slot* slots(Node* node) {
+        return (Slot*)node->data;
+    }
+
+    static const Slot* slots(const Node* node) {
+        return (const Slot*)node->data;
+    }
+
+    static const char* prefix(const Node* node) {
+        return node->data + DATA_BYTES - node->prefixLength;
+    }
+
+    static size_t freeSpace(const Node* node) {
+        return node->heapStart - node->count * sizeof(Slot);
+    }
+
+    // Function to get the head of a key remainder: its first 4 bytes, big-endian, zero-padded
+    static uint32_t headOf(const char* bytes, size_t length) {
+        uint32_t head = 0;
+        for (size_t i = 0; i < 4; i++) {
+            head = (head << 8) | (i < length ? (unsigned char)bytes[i] : 0);
+        }
+        return head;
+    }
+
+    static std::string keyAt(const Node* node, int i) {
+        const Slot& slot = slots(node)[i];
+        return std::string(prefix(node), node->prefixLength) + std::string(node->data + slot.offset, slot.length);
+    }
+
+    // Function to check whether the key in slot i equals k, without building the key
+    static bool keyEquals(const Node* node, int i, const std::string& k) {
+        const Slot& slot = slots(node)[i];
+        size_t pl = node->prefixLength;
+        return k.size() == pl + slot.length && memcmp(k.data(), prefix(node), pl) == 0 &&
+               memcmp(k.data() + pl, node->data + slot.offset, slot.length) == 0;
+    }
+
+    static const char* payloadAt(const Node* node, int i) {
+        const Slot& slot = slots(node)[i];
+        return node->data + slot.offset + slot.length;
+    }
+
+    static Node* childAt(const Node* node, int i) {
+        if (i == node->count) {
+            return node->link;
+        }
+        Node* child;
+        memcpy(&child, payloadAt(node, i), sizeof(Node*));
+        return child;
+    }
+
+    static void setChild(Node* node, int i, Node* child) {
+        if (i == node->count) {
+            node->link = child;
+        } else {
+            memcpy((char*)payloadAt(node, i), &child, sizeof(Node*));
+        }
+    }
+
+    /*
+     * Function to find the first slot whose key is >= k (or > k if `upper`).
+     * The key is first compared with the node prefix; if it does not share it, it sorts
+     * before or after every key in the node. Otherwise its remainder is binary searched by
+     * head, falling back to the full remainder only when heads are equal.
+     */
+    static int bound(const Node* node, const std::string& k, bool upper) {
+        size_t pl = node->prefixLength;
+        int c = memcmp(k.data(), prefix(node), std::min(k.size(), pl));
+        if (c < 0 || (c == 0 && k.size() < pl)) {
+            return 0;
+        }
+        if (c > 0) {
+            return node->count;
+        }
+
+        const char* rest = k.data() + pl;
+        size_t restLength = k.size() - pl;
+        uint32_t head = headOf(rest, restLength);
+        const Slot* s = slots(node);
+        int lo = 0, hi = node->count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            int order; // Order of the slot's key relative to k
+            if (s[mid].head != head) {
+                order = s[mid].head < head ? -1 : 1;
+            } else {
+                order = memcmp(node->data + s[mid].offset, rest, std::min<size_t>(s[mid].length, restLength));
+                if (order == 0) {
+                    order = (s[mid].length < restLength) ? -1 : (s[mid].length > restLength ? 1 : 0);
+                }
+            }
+            if (order < 0 || (upper && order == 0)) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Function to decode every entry of a node
+    static std::vector<Entry> decode(const Node* node) {
+        std::vector<Entry> result(node->count);
+        for (int i = 0; i < node->count; i++) {
+            result[i].first = keyAt(node, i);
+            result[i].second.assign(payloadAt(node, i), payloadSize(node));
+        }
+        return result;
+    }
+
+    static size_t commonPrefix(const std::string& a, const std::string& b) {
+        size_t n = 0;
+        while (n < a.size() && n < b.size() && a[n] == b[n]) {
+            n++;
+        }
+        return n;
+    }
+
+    // Function to rewrite a node from sorted entries; the prefix is the one all of them share
+    static void build(Node* node, const std::vector<Entry>& from, size_t begin, size_t end) {
+        size_t pl = (begin < end) ? commonPrefix(from[begin].first, from[end - 1].first) : 0;
+        node->count = 0;
+        node->prefixLength = pl;
+        node->heapStart = DATA_BYTES - pl;
+        if (pl > 0) {
+            memcpy(node->data + node->heapStart, from[begin].first.data(), pl);
+        }
+        for (size_t i = begin; i < end; i++) {
+            const std::string& key = from[i].first;
+            size_t length = key.size() - pl;
+            node->heapStart -= length + from[i].second.size();
+            memcpy(node->data + node->heapStart, key.data() + pl, length);
+            memcpy(node->data + node->heapStart + length, from[i].second.data(), from[i].second.size());
+            slots(node)[node->count++] = Slot{headOf(key.data() + pl, length), node->heapStart, (uint16_t)length};
+        }
+    }
+
+    static size_t entryBytes(const Entry& e) {
+        return sizeof(Slot) + e.first.size() + e.second.size();
+    }
+
+    // Function to get the bytes entries [begin, end) take in a node, given prefix sums of entryBytes
+    static size_t packedBytes(const std::vector<Entry>& all, const std::vector<size_t>& sums, size_t begin, size_t end) {
+        size_t pl = commonPrefix(all[begin].first, all[end - 1].first);
+        return sums[end] - sums[begin] - (end - begin - 1) * pl;
+    }
+
+    /*
+     * Function to insert an entry at position pos of `node`. If the key fits and shares the
+     * node prefix it is written in place; otherwise the node is rebuilt, and split by bytes
+     * when the entries no longer fit. Returns the new right sibling on a split, with the key
+     * that separates the halves in `separator`.
+     */
+    Node* insertEntry(Node* node, int pos, const std::string& key, const char* payload, std::string& separator) {
+        size_t pl = node->prefixLength;
+        size_t length = key.size() - std::min(key.size(), pl);
+        bool sharesPrefix = key.size() >= pl && memcmp(key.data(), prefix(node), pl) == 0;
+        if (sharesPrefix && freeSpace(node) >= sizeof(Slot) + length + payloadSize(node)) {
+            Slot* s = slots(node);
+            for (int i = node->count; i > pos; i--) {
+                s[i] = s[i - 1];
+            }
+            node->heapStart -= length + payloadSize(node);
+            memcpy(node->data + node->heapStart, key.data() + pl, length);
+            memcpy(node->data + node->heapStart + length, payload, payloadSize(node));
+            s[pos] = Slot{headOf(key.data() + pl, length), node->heapStart, (uint16_t)length};
+            node->count++;
+            return nullptr;
+        }
+
+        std::vector<Entry> all = decode(node);
+        all.insert(all.begin() + pos, Entry(key, std::string(payload, payloadSize(node))));
+        std::vector<size_t> sums(all.size() + 1, 0);
+        for (size_t i = 0; i < all.size(); i++) {
+            sums[i + 1] = sums[i] + entryBytes(all[i]);
+        }
+        if (packedBytes(all, sums, 0, all.size()) <= DATA_BYTES) {
+            build(node, all, 0, all.size()); // Only the prefix had to change
+            return nullptr;
+        }
+
+        /*
+         * Split where the packed halves are closest in size. A leaf splits into [0, m) and
+         * [m, size); an inner node sends entry m up. Some split always fits: if the new key
+         * shares the node prefix, the halves together are at most one entry over a node;
+         * otherwise the new key sorts before or after every other key and can go alone.
+         */
+        bool leaf = node->leaf;
+        size_t m = 0, best = SIZE_MAX;
+        for (size_t i = 1; i + (leaf ? 0 : 1) < all.size(); i++) {
+            size_t left = packedBytes(all, sums, 0, i);
+            size_t right = packedBytes(all, sums, leaf ? i : i + 1, all.size());
+            if (left <= DATA_BYTES && right <= DATA_BYTES && std::max(left, right) < best) {
+                best = std::max(left, right);
+                m = i;
+            }
+        }
+
+        Node* right = newNode(leaf);
+        if (leaf) {
+            // Shortest separator s with left's last key < s <= right's first key
+            const std::string& last = all[m - 1].first;
+            const std::string& first = all[m].first;
+            separator = first.substr(0, commonPrefix(last, first) + 1);
+            build(right, all, m, all.size());
+            build(node, all, 0, m);
+            right->link = node->link;
+            node->link = right;
+        } else {
+            // The middle key moves up; its child becomes the left half's rightmost child
+            separator = all[m].first;
+            Node* middleChild;
+            memcpy(&middleChild, all[m].second.data(), sizeof(Node*));
+            right->link = node->link;
+            build(right, all, m + 1, all.size());
+            build(node, all, 0, m);
+            node->link = middleChild;
+        }
+        return right;
+    }
+
+    Node* newNode(bool leaf) {
+        Node* node = new Node;
+        node->count = 0;
+        node->prefixLength = 0;
+        node->heapStart = DATA_BYTES;
+        node->leaf = leaf;
+        node->link = nullptr;
+        nodes++;
+        return node;
+    }
+
+    static void destroy(Node* node) {
+        if (!node->leaf) {
+            for (int i = 0; i <= node->count; i++) {
+                destroy(childAt(node, i));
+            }
+        }
+        delete node;
+    }
+
+    Node* insertInto(Node* node, const std::string& k, const V& v, std::string& separator, bool& added) {
+        if (node->leaf) {
+            int pos = bound(node, k, false);
+            if (pos < node->count && keyEquals(node, pos, k)) {
+                memcpy((char*)payloadAt(node, pos), &v, sizeof(V)); // Existing key: replace the value
+                added = false;
+                return nullptr;
+            }
+            added = true;
+            return insertEntry(node, pos, k, (const char*)&v, separator);
+        }
+
+        int i = bound(node, k, true);
+        Node* child = childAt(node, i);
+        std::string childSeparator;
+        Node* newChild = insertInto(child, k, v, childSeparator, added);
+        if (newChild == nullptr) {
+            return nullptr;
+        }
+        // child now holds the keys below childSeparator and newChild the rest of its range
+        setChild(node, i, newChild);
+        return insertEntry(node, i, childSeparator, (const char*)&child, separator);
+    }
+
+    const Node* findLeaf(const std::string& k) const {
+        const Node* node = root;
+        while (!node->leaf) {
+            node = childAt(node, bound(node, k, true));
+        }
+        return node;
+    }
+
+public:
+    StringBTreeMap() : entries(0), levels(1), nodes(0) {
+        root = newNode(true);
+    }
+
+    ~StringBTreeMap() {
+        destroy(root);
+    }
+
+    StringBTreeMap(const StringBTreeMap&) = delete;
+    StringBTreeMap& operator=(const StringBTreeMap&) = delete;
+
+    // Function to insert a key with a value; returns false if the key existed (its value is replaced)
+    bool insert(const std::string& k, const V& v) {
+        if (k.size() > MAX_KEY_LENGTH) {
+            throw std::length_error("key longer than StringBTreeMap::MAX_KEY_LENGTH");
+        }
+        std::string separator;
+        bool added = false;
+        Node* right = insertInto(root, k, v, separator, added);
+        if (right != nullptr) { // The root was split: the tree grows by one level
+            Node* newRoot = newNode(false);
+            std::string unused;
+            newRoot->link = right;
+            insertEntry(newRoot, 0, separator, (const char*)&root, unused);
+            root = newRoot;
+            levels++;
+        }
+        entries += added;
+        return added;
+    }
+
+    // Function to look up a key; stores its value in `value` and returns whether it was found
+    bool find(const std::string& k, V& value) const {
+        const Node* leaf = findLeaf(k);
+        int pos = bound(leaf, k, false);
+        if (pos < leaf->count && keyEquals(leaf, pos, k)) {
+            memcpy(&value, payloadAt(leaf, pos), sizeof(V)); // Payloads are not aligned
+            return true;
+        }
+        return false;
+    }
+
+    // Function to get all (key, value) pairs with lo <= key <= hi in key order
+    std::vector<std::pair<std::string, V>> scan(const std::string& lo, const std::string& hi) const {
+        std::vector<std::pair<std::string, V>> result;
+        const Node* leaf = findLeaf(lo);
+        for (int i = bound(leaf, lo, false); leaf != nullptr; leaf = leaf->link, i = 0) {
+            for (; i < leaf->count; i++) {
+                std::string key = keyAt(leaf, i);
+                if (key > hi) {
+                    return result;
+                }
+                V value;
+                memcpy(&value, payloadAt(leaf, i), sizeof(V));
+                result.push_back({key, value});
+            }
+        }
+        return result;
+    }
+
+    size_t size() const {
+        return entries;
+    }
+
+    // Function to get the number of levels (1 for a single leaf)
+    int height() const {
+        return levels;
+    }
+
+    // Function to get the memory used by all nodes, in bytes
+    size_t memoryUsage() const {
+        return nodes * sizeof(Node);
+    }
+};
+
+// With std::string keys, the default order and trivially copyable values, BTreeMap uses the slotted string layout
+template <typename V, int Capacity>
+class BTreeMap<std::string, V, std::less<std::string>, Capacity, true> : public StringBTreeMap<V> {};
+
+} // namespace btree
+
+#endif
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdio>
+#include <stdexcept>
+#include "benchmark_harness.h"
+using namespace std;
+
+/*
+ * Function to read the case lines of a result file, keyed by "benchmark case".
+ * A case that occurs more than once (results appended by several runs) keeps its last line.
+ */
+map<string, map<string, string>> readResults(const string& path, vector<string>& order) {
+    ifstream in(path);
+    if (!in) {
+        throw runtime_error("cannot open " + path);
+    }
+    map<string, map<string, string>> results;
+    string line;
+    while (getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos) continue;
+        map<string, string> fields = bench::parseJsonLine(line);
+        if (fields["type"] != "case") continue;
+        string key = fields["benchmark"] + " " + fields["case"];
+        if (results.count(key) == 0) order.push_back(key);
+        results[key] = fields;
+    }
+    return results;
+}
+
+// Function to get the relative change from `before` to `after` in percent
+double percentChange(double before, double after) {
+    return before > 0 ? (after - before) / before * 100 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) {
+            throw invalid_argument(string("usage: ") + argv[0] + " <baseline.jsonl> <candidate.jsonl> [--threshold percent]");
+        }
+        double threshold = 5;
+        for (int a = 3; a + 1 < argc; a += 2) {
+            if (string(argv[a]) == "--threshold") threshold = stod(argv[a + 1]);
+            else throw invalid_argument(string("unknown option ") + argv[a]);
+        }
+
+        vector<string> baselineOrder, candidateOrder;
+        map<string, map<string, string>> baseline = readResults(argv[1], baselineOrder);
+        map<string, map<string, string>> candidate = readResults(argv[2], candidateOrder);
+
+        int regressions = 0, improvements = 0, changedResults = 0;
+        printf("%-72s %11s %11s %8s %8s %9s  %s\n", "Case", "Base ms", "New ms", "Median", "p99", "Allocs", "Verdict");
+        for (const string& key : candidateOrder) {
+            auto found = baseline.find(key);
+            if (found == baseline.end()) {
+                printf("%-72s %11s %11.3f %8s %8s %9s  new case\n", key.c_str(), "-",
+                       stod(candidate[key]["median_ns"]) / 1e6, "", "", "");
+                continue;
+            }
+            map<string, string>& before = found->second;
+            map<string, string>& after = candidate[key];
+            double medianBefore = stod(before["median_ns"]), medianAfter = stod(after["median_ns"]);
+            double medianChange = percentChange(medianBefore, medianAfter);
+            double p99Change = percentChange(stod(before["p99_ns"]), stod(after["p99_ns"]));
+            long long allocationChange = stoll(after["allocations"]) - stoll(before["allocations"]);
+
+            // Times are noisy, so only changes beyond the threshold count; allocation counts are exact
+            string verdict;
+            if (before["checksum"] != after["checksum"]) {
+                verdict += "RESULT CHANGED ";
+                changedResults++;
+            }
+            if (medianChange > threshold) {
+                verdict += "SLOWER ";
+                regressions++;
+            } else if (medianChange < -threshold) {
+                verdict += "faster ";
+                improvements++;
+            }
+            if (allocationChange > 0) {
+                verdict += "MORE ALLOCATIONS ";
+                regressions++;
+            }
+            printf("%-72s %11.3f %11.3f %+7.1f%% %+7.1f%% %+9lld  %s\n", key.c_str(), medianBefore / 1e6,
+                   medianAfter / 1e6, medianChange, p99Change, allocationChange, verdict.c_str());
+        }
+        for (const string& key : baselineOrder) {
+            if (candidate.count(key) == 0) {
+                printf("%-72s %11.3f %11s %8s %8s %9s  missing\n", key.c_str(), stod(baseline[key]["median_ns"]) / 1e6,
+                       "-", "", "", "");
+            }
+        }
+
+        printf("\n%d regressions, %d improvements, %d changed results (threshold %g%%)\n", regressions, improvements,
+               changedResults, threshold);
+        return regressions > 0 || changedResults > 0 ? 1 : 0;
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 2;
+    }
+}
+/*
+ * Benchmark Comparison Explanation:
+ *
+ * Purpose:
+ *  - Compares two result files of the benchmarks built on benchmark_harness.h, e.g. one run
+ *    on the parent commit and one on the change under review, and flags regressions.
+ *
+ * Key Concepts:
+ *  - Cases are matched by benchmark and case name; the verdict lists:
+ *     * SLOWER / faster: the median time changed by more than the threshold (default 5%).
+ *     * MORE ALLOCATIONS: the median number of allocations per repetition went up. The
+ *       count does not depend on timing noise, so any increase is reported.
+ *     * RESULT CHANGED: the checksum of the result differs, i.e. the algorithm now computes
+ *       something else on the same seeded input.
+ *  - Cases only in one file are listed as new or missing.
+ *
+ * Input:
+ *  - `<baseline.jsonl> <candidate.jsonl> [--threshold percent]`, where each file holds the
+ *    output of one or more benchmark runs (`--out` appends).
+ *
+ * Output:
+ *  - One line per case and a summary. The exit code is 1 if there is a regression or a
+ *    changed result and 0 otherwise, so that a script can stop on it; 2 on errors.
+ */
@@ -0,0 +1,652 @@
+#ifndef CONCURRENT_BTREE_H
+#define CONCURRENT_BTREE_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+
+/*
+ * Concurrent B+ Tree mapping int keys to int values.
+ * Contains:
+ *  - `EpochManager`: Epoch-based reclamation; a node removed from the tree is freed only
+ *    after every thread that might still be reading it has finished its operation.
+ *  - `ConcurrentBTree`: The tree, synchronized with optimistic lock coupling.
+ * Optimistic lock coupling:
+ *  - Every node has a version word: bit 1 is the write lock, bit 0 marks a node that was
+ *    removed from the tree, and the rest counts modifications.
+ *  - Readers never write shared memory. They note a node's version, read the node, and check
+ *    that the version is unchanged before trusting what they read (or before moving on to a
+ *    child). A changed version means a writer interfered, and the operation restarts from the
+ *    root. Because nothing is written, lookups do not bounce cache lines between cores.
+ *  - Writers descend the same way and only lock (by upgrading the version they read) the nodes
+ *    they modify: the leaf, or the parent and child during a split.
+ *  - Full nodes are split on the way down (as in `BTree`), so a split never has to lock more
+ *    than a parent and one child.
+ * Node contents read before validation may be inconsistent; every index derived from them is
+ * bounds-checked and discarded when validation fails. A leaf is only trusted after both it and
+ * its parent validate, since a split changes the parent and may move keys out of the leaf.
+ */
+namespace btree {
+
+/*
+ * Epoch-based reclamation.
+ * Every operation runs inside a `Guard`, which publishes the global epoch in the calling
+ * thread's slot for the duration of the operation. A retired node is tagged with the epoch it
+ * was retired in; once every active thread has published a later epoch, no thread can still
+ * hold a pointer to it, and it is freed two epochs later.
+ * Threads are given slot indexes from a process-wide pool that recycles the index of a thread
+ * when it exits, so any number of short-lived threads can use the tree.
+ */
+class EpochManager {
+public:
+    static const int MAX_THREADS = 1024;
+
+private:
+    static const uint64_t INACTIVE = UINT64_MAX;
+    static const int RETIRES_PER_ADVANCE = 64;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{INACTIVE};
+        std::vector<std::pair<uint64_t, void*>> retired; // Only the owning thread touches these
+    };
+
+    std::atomic<uint64_t> globalEpoch{2};
+    Slot slots[MAX_THREADS];
+
+    // Process-wide pool of thread indexes
+    struct ThreadIndexPool {
+        std::mutex lock;
+        std::vector<int> free;
+        int next = 0;
+    };
+
+    static ThreadIndexPool& indexPool() {
+        static ThreadIndexPool pool;
+        return pool;
+    }
+
+    // Holds the calling thread's index for its lifetime
+    struct ThreadIndex {
+        int index;
+
+        ThreadIndex() {
+            ThreadIndexPool& pool = indexPool();
+            std::lock_guard<std::mutex> guard(pool.lock);
+            if (!pool.free.empty()) {
+                index = pool.free.back();
+                pool.free.pop_back();
+            } else if (pool.next < MAX_THREADS) {
+                index = pool.next++;
+            } else {
+                throw std::runtime_error("EpochManager: too many live threads");
+            }
+        }
+
+        ~ThreadIndex() {
+            ThreadIndexPool& pool = indexPool();
+            std::lock_guard<std::mutex> guard(pool.lock);
+            pool.free.push_back(index);
+        }
+    };
+
+    static int threadIndex() {
+        thread_local ThreadIndex index;
+        return index.index;
+    }
+
+    // Function to advance the global epoch if every active thread has seen the current one
+    void tryAdvance() {
+        uint64_t current = globalEpoch.load();
+        for (const Slot& slot : slots) {
+            uint64_t e = slot.epoch.load();
+            if (e != INACTIVE && e != current) {
+                return;
+            }
+        }
+        globalEpoch.compare_exchange_strong(current, current + 1);
+    }
+
+    void (*deleter)(void*);
+
+public:
+    // Constructor: `_deleter` frees one retired object
+    explicit EpochManager(void (*_deleter)(void*)) : deleter(_deleter) {}
+
+    // Destructor: frees everything still waiting; no thread may be inside a Guard
+    ~EpochManager() {
+        for (Slot& slot : slots) {
+            for (const std::pair<uint64_t, void*>& entry : slot.retired) {
+                deleter(entry.second);
+            }
+        }
+    }
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    // Marks the calling thread as active in the current epoch for its lifetime
+    class Guard {
+    private:
+        Slot& slot;
+
+    public:
+        explicit Guard(EpochManager& manager) : slot(manager.slots[threadIndex()]) {
+            // Sequentially consistent, so the store is visible before any node is read
+            slot.epoch.store(manager.globalEpoch.load());
+        }
+
+        ~Guard() {
+            slot.epoch.store(INACTIVE, std::memory_order_release);
+        }
+    };
+
+    // Function to hand over an object that is no longer reachable from the tree
+    void retire(void* object) {
+        Slot& slot = slots[threadIndex()];
+        slot.retired.push_back({globalEpoch.load(), object});
+        if (slot.retired.size() % RETIRES_PER_ADVANCE != 0) {
+            return;
+        }
+
+        tryAdvance();
+        uint64_t safe = globalEpoch.load() - 2; // Nobody can still be in this epoch or earlier
+        size_t kept = 0;
+        for (const std::pair<uint64_t, void*>& entry : slot.retired) {
+            if (entry.first <= safe) {
+                deleter(entry.second);
+            } else {
+                slot.retired[kept++] = entry;
+            }
+        }
+        slot.retired.resize(kept);
+    }
+};
+
+class ConcurrentBTree {
+private:
+    static const int LEAF_CAPACITY = 64;
+    static const int INNER_CAPACITY = 64;
+
+    struct Node {
+        std::atomic<uint64_t> version{4};
+        const bool leaf;
+        int count = 0;
+
+        explicit Node(bool _leaf) : leaf(_leaf) {}
+
+        static bool isLocked(uint64_t v) {
+            return (v & 2) != 0;
+        }
+
+        static bool isObsolete(uint64_t v) {
+            return (v & 1) != 0;
+        }
+
+        // Function to read the version before reading the node; fails if it is being written
+        uint64_t readLockOrRestart(bool& needRestart) const {
+            uint64_t v = version.load();
+            if (isLocked(v) || isObsolete(v)) {
+                needRestart = true;
+            }
+            return v;
+        }
+
+        // Function to check that the node did not change since its version was read
+        void checkOrRestart(uint64_t v, bool& needRestart) const {
+            if (version.load() != v) {
+                needRestart = true;
+            }
+        }
+
+        // Function to take the write lock, provided the node is still at version v
+        void upgradeToWriteLockOrRestart(uint64_t& v, bool& needRestart) {
+            if (version.compare_exchange_strong(v, v + 2)) {
+                v += 2;
+            } else {
+                needRestart = true;
+            }
+        }
+
+        void writeUnlock() {
+            version.fetch_add(2);
+        }
+
+        // Function to unlock a node that was removed from the tree
+        void writeUnlockObsolete() {
+            version.fetch_add(3);
+        }
+    };
+
+    struct Leaf : Node {
+        int keys[LEAF_CAPACITY];
+        int values[LEAF_CAPACITY];
+
+        Leaf() : Node(true) {}
+
+        // Function to find the index of the first key greater than or equal to k
+        int lowerBound(int k) const {
+            int lo = 0, hi = count;
+            if (hi > LEAF_CAPACITY) hi = LEAF_CAPACITY; // Torn read; validation will fail
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (keys[mid] < k) lo = mid + 1;
+                else hi = mid;
+            }
+            return lo;
+        }
+    };
+
+    /*
+     * Inner node: children[i] holds the keys in (keys[i - 1], keys[i]]; the last child holds
+     * the keys above keys[count - 1].
+     */
+    struct Inner : Node {
+        int keys[INNER_CAPACITY];
+        Node* children[INNER_CAPACITY + 1];
+
+        Inner() : Node(false) {}
+
+        int lowerBound(int k) const {
+            int lo = 0, hi = count;
+            if (hi > INNER_CAPACITY) hi = INNER_CAPACITY;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (keys[mid] < k) lo = mid + 1;
+                else hi = mid;
+            }
+            return lo;
+        }
+
+        // Function to insert separator k with `right` as the child after it (caller holds the lock)
+        void insertChild(int k, Node* right) {
+            int pos = lowerBound(k);
+            for (int i = count; i > pos; i--) {
+                keys[i] = keys[i - 1];
+                children[i + 1] = children[i];
+            }
+            keys[pos] = k;
+            children[pos + 1] = right;
+            count++;
+        }
+    };
+
+    std::atomic<Node*> root;
+    EpochManager epochs;
+
+    static void deleteNode(void* object) {
+        Node* node = (Node*)object;
+        if (node->leaf) delete (Leaf*)node;
+        else delete (Inner*)node;
+    }
+
+    static void destroy(Node* node) {
+        if (!node->leaf) {
+            Inner* inner = (Inner*)node;
+            for (int i = 0; i <= inner->count; i++) {
+                destroy(inner->children[i]);
+            }
+        }
+        deleteNode(node);
+    }
+
+    // Function to split a locked full node; returns the new right half and the separator
+    static Node* split(Node* node, int& separator) {
+        if (node->leaf) {
+            Leaf* left = (Leaf*)node;
+            Leaf* right = new Leaf();
+            int mid = left->count / 2;
+            right->count = left->count - mid;
+            for (int i = 0; i < right->count; i++) {
+                right->keys[i] = left->keys[mid + i];
+                right->values[i] = left->values[mid + i];
+            }
+            left->count = mid;
+            separator = left->keys[mid - 1];
+            return right;
+        }
+        Inner* left = (Inner*)node;
+        Inner* right = new Inner();
+        int mid = left->count / 2;
+        right->count = left->count - mid - 1;
+        for (int i = 0; i < right->count; i++) {
+            right->keys[i] = left->keys[mid + 1 + i];
+        }
+        for (int i = 0; i <= right->count; i++) {
+            right->children[i] = left->children[mid + 1 + i];
+        }
+        left->count = mid;
+        separator = left->keys[mid];
+        return right;
+    }
+
+    static bool isFull(const Node* node) {
+        return node->count >= (node->leaf ? LEAF_CAPACITY : INNER_CAPACITY);
+    }
+
+    /*
+     * Function to split `node` (at version v) whose parent is `parent` (at version pv, or null
+     * if node is the root). Returns false if either node changed; the caller then restarts.
+     */
+    bool splitLocked(Inner* parent, uint64_t pv, Node* node, uint64_t v) {
+        bool needRestart = false;
+        if (parent != nullptr) {
+            parent->upgradeToWriteLockOrRestart(pv, needRestart);
+            if (needRestart) return false;
+        }
+        node->upgradeToWriteLockOrRestart(v, needRestart);
+        if (needRestart) {
+            if (parent != nullptr) parent->writeUnlock();
+            return false;
+        }
+        if (parent == nullptr && node != root.load()) {
+            node->writeUnlock(); // Another thread grew the tree meanwhile
+            return false;
+        }
+
+        int separator;
+        Node* right = split(node, separator);
+        if (parent != nullptr) {
+            parent->insertChild(separator, right);
+        } else {
+            Inner* newRoot = new Inner();
+            newRoot->count = 1;
+            newRoot->keys[0] = separator;
+            newRoot->children[0] = node;
+            newRoot->children[1] = right;
+            root.store(newRoot);
+        }
+        node->writeUnlock();
+        if (parent != nullptr) parent->writeUnlock();
+        return true;
+    }
+
+    // Function to back off after a failed attempt; matters when threads outnumber cores
+    static void backoff(int restarts) {
+        if (restarts > 2) {
+            std::this_thread::yield();
+        }
+    }
+
+public:
+    ConcurrentBTree() : root(new Leaf()), epochs(deleteNode) {}
+
+    // Destructor: no thread may be using the tree
+    ~ConcurrentBTree() {
+        destroy(root.load());
+    }
+
+    ConcurrentBTree(const ConcurrentBTree&) = delete;
+    ConcurrentBTree& operator=(const ConcurrentBTree&) = delete;
+
+    // Function to look up a key; stores its value and returns true if it is present
+    bool search(int k, int& value) {
+        EpochManager::Guard guard(epochs);
+        for (int restarts = 0;; restarts++) {
+            backoff(restarts);
+            bool needRestart = false;
+            Node* node = root.load();
+            uint64_t v = node->readLockOrRestart(needRestart);
+            if (needRestart || node != root.load()) continue;
+
+            Inner* parent = nullptr;
+            uint64_t pv = 0;
+            while (!node->leaf) {
+                Inner* inner = (Inner*)node;
+                if (parent != nullptr) {
+                    parent->checkOrRestart(pv, needRestart);
+                    if (needRestart) break;
+                }
+                parent = inner;
+                pv = v;
+                node = inner->children[inner->lowerBound(k)];
+                inner->checkOrRestart(v, needRestart); // The child pointer was read consistently
+                if (needRestart) break;
+                v = node->readLockOrRestart(needRestart);
+                if (needRestart) break;
+            }
+            if (needRestart) continue;
+
+            Leaf* leaf = (Leaf*)node;
+            int pos = leaf->lowerBound(k);
+            bool found = pos < leaf->count && pos < LEAF_CAPACITY && leaf->keys[pos] == k;
+            int result = found ? leaf->values[pos] : 0;
+            if (parent != nullptr) {
+                parent->checkOrRestart(pv, needRestart); // The leaf was not split meanwhile
+            }
+            leaf->checkOrRestart(v, needRestart);
+            if (needRestart) continue;
+            if (found) value = result;
+            return found;
+        }
+    }
+
+    // Function to insert a key with a value; an existing key gets the new value
+    void insert(int k, int value) {
+        EpochManager::Guard guard(epochs);
+        for (int restarts = 0;; restarts++) {
+            backoff(restarts);
+            bool needRestart = false;
+            Node* node = root.load();
+            uint64_t v = node->readLockOrRestart(needRestart);
+            if (needRestart || node != root.load()) continue;
+
+            Inner* parent = nullptr;
+            uint64_t pv = 0;
+            bool splitDone = false;
+            while (true) {
+                if (isFull(node)) {
+                    splitLocked(parent, pv, node, v); // Success or not, retry from the root
+                    splitDone = true;
+                    break;
+                }
+                if (node->leaf) break;
+
+                Inner* inner = (Inner*)node;
+                if (parent != nullptr) {
+                    parent->checkOrRestart(pv, needRestart);
+                    if (needRestart) break;
+                }
+                parent = inner;
+                pv = v;
+                node = inner->children[inner->lowerBound(k)];
+                inner->checkOrRestart(v, needRestart);
+                if (needRestart) break;
+                v = node->readLockOrRestart(needRestart);
+                if (needRestart) break;
+            }
+            if (needRestart || splitDone) continue;
+
+            Leaf* leaf = (Leaf*)node;
+            leaf->upgradeToWriteLockOrRestart(v, needRestart);
+            if (needRestart) continue;
+            if (parent != nullptr) {
+                parent->checkOrRestart(pv, needRestart);
+                if (needRestart) {
+                    leaf->writeUnlock();
+                    continue;
+                }
+            }
+
+            int pos = leaf->lowerBound(k);
+            if (pos < leaf->count && leaf->keys[pos] == k) {
+                leaf->values[pos] = value;
+            } else {
+                for (int i = leaf->count; i > pos; i--) {
+                    leaf->keys[i] = leaf->keys[i - 1];
+                    leaf->values[i] = leaf->values[i - 1];
+                }
+                leaf->keys[pos] = k;
+                leaf->values[pos] = value;
+                leaf->count++;
+            }
+            leaf->writeUnlock();
+            return;
+        }
+    }
+
+    /*
+     * Function to remove a key; returns false if it is not in the tree.
+     * A leaf whose last key is removed is unlinked from its parent (when the parent has
+     * another child), marked obsolete and handed to the epoch manager; readers that still
+     * reach it see the obsolete bit and restart.
+     */
+    bool remove(int k) {
+        EpochManager::Guard guard(epochs);
+        for (int restarts = 0;; restarts++) {
+            backoff(restarts);
+            bool needRestart = false;
+            Node* node = root.load();
+            uint64_t v = node->readLockOrRestart(needRestart);
+            if (needRestart || node != root.load()) continue;
+
+            Inner* parent = nullptr;
+            uint64_t pv = 0;
+            int childIndex = 0;
+            while (!node->leaf) {
+                Inner* inner = (Inner*)node;
+                if (parent != nullptr) {
+                    parent->checkOrRestart(pv, needRestart);
+                    if (needRestart) break;
+                }
+                parent = inner;
+                pv = v;
+                childIndex = inner->lowerBound(k);
+                node = inner->children[childIndex];
+                inner->checkOrRestart(v, needRestart);
+                if (needRestart) break;
+                v = node->readLockOrRestart(needRestart);
+                if (needRestart) break;
+            }
+            if (needRestart) continue;
+
+            Leaf* leaf = (Leaf*)node;
+            int pos = leaf->lowerBound(k);
+            if (pos >= leaf->count || leaf->keys[pos] != k) {
+                if (parent != nullptr) {
+                    parent->checkOrRestart(pv, needRestart);
+                }
+                leaf->checkOrRestart(v, needRestart);
+                if (needRestart) continue;
+                return false;
+            }
+
+            bool unlink = leaf->count == 1 && parent != nullptr && parent->count > 0;
+            if (unlink) {
+                parent->upgradeToWriteLockOrRestart(pv, needRestart);
+                if (needRestart) continue;
+            }
+            leaf->upgradeToWriteLockOrRestart(v, needRestart);
+            if (needRestart) {
+                if (unlink) parent->writeUnlock();
+                continue;
+            }
+            if (!unlink && parent != nullptr) {
+                parent->checkOrRestart(pv, needRestart);
+                if (needRestart) {
+                    leaf->writeUnlock();
+                    continue;
+                }
+            }
+
+            if (unlink) {
+                // The neighbouring child takes over the leaf's key range with the separator gone
+                int sep = (childIndex < parent->count) ? childIndex : childIndex - 1;
+                for (int i = sep + 1; i < parent->count; i++) {
+                    parent->keys[i - 1] = parent->keys[i];
+                }
+                for (int i = childIndex + 1; i <= parent->count; i++) {
+                    parent->children[i - 1] = parent->children[i];
+                }
+                parent->count--;
+                leaf->count = 0;
+                leaf->writeUnlockObsolete();
+                parent->writeUnlock();
+                epochs.retire(leaf);
+                return true;
+            }
+
+            for (int i = pos + 1; i < leaf->count; i++) {
+                leaf->keys[i - 1] = leaf->keys[i];
+                leaf->values[i - 1] = leaf->values[i];
+            }
+            leaf->count--;
+            leaf->writeUnlock();
+            return true;
+        }
+    }
+
+    /*
+     * Function to read up to `limit` (key, value) pairs with key >= lo, in key order.
+     * Each leaf is read optimistically and validated on its own, then the scan continues by
+     * descending again from the key right after the leaf's upper bound (taken from the
+     * separators on the path), so no sibling pointers are needed. The result is not a
+     * snapshot: keys changed by other threads during the scan may or may not be seen.
+     */
+    std::vector<std::pair<int, int>> scan(int lo, int limit) {
+        EpochManager::Guard guard(epochs);
+        std::vector<std::pair<int, int>> result;
+        int restarts = 0;
+        while ((int)result.size() < limit) {
+            backoff(restarts++);
+            bool needRestart = false;
+            Node* node = root.load();
+            uint64_t v = node->readLockOrRestart(needRestart);
+            if (needRestart || node != root.load()) continue;
+
+            bool bounded = false; // Whether the leaf has an upper bound
+            int upper = INT_MAX;
+            Inner* parent = nullptr;
+            uint64_t pv = 0;
+            while (!node->leaf) {
+                Inner* inner = (Inner*)node;
+                if (parent != nullptr) {
+                    parent->checkOrRestart(pv, needRestart);
+                    if (needRestart) break;
+                }
+                parent = inner;
+                pv = v;
+                int i = inner->lowerBound(lo);
+                if (i < inner->count) {
+                    bounded = true;
+                    upper = inner->keys[i];
+                }
+                node = inner->children[i];
+                inner->checkOrRestart(v, needRestart);
+                if (needRestart) break;
+                v = node->readLockOrRestart(needRestart);
+                if (needRestart) break;
+            }
+            if (needRestart) continue;
+
+            Leaf* leaf = (Leaf*)node;
+            size_t before = result.size();
+            int count = leaf->count < LEAF_CAPACITY ? leaf->count : LEAF_CAPACITY;
+            for (int i = leaf->lowerBound(lo); i < count && (int)result.size() < limit; i++) {
+                result.push_back({leaf->keys[i], leaf->values[i]});
+            }
+            if (parent != nullptr) {
+                parent->checkOrRestart(pv, needRestart);
+            }
+            leaf->checkOrRestart(v, needRestart);
+            if (needRestart) {
+                result.resize(before);
+                continue;
+            }
+            restarts = 0;
+            if (!bounded || upper == INT_MAX) {
+                break; // That was the last leaf
+            }
+            lo = upper + 1;
+        }
+        return result;
+    }
+};
+
+} // namespace btree
+
+#endif
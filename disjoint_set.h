@@ -0,0 +1,184 @@
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+/*
+ * Disjoint-set (union-find) structures.
+ * Contains:
+ *  - `DisjointSet`: Sequential union-find in a single int array.
+ *  - `ConcurrentDisjointSet`: Lock-free union-find for use from many threads.
+ * Elements are the integers 0 .. n-1.
+ */
+namespace mst {
+
+/*
+ * Sequential disjoint set.
+ * Contains:
+ *  - `parent`: For a non-root the index of its parent; for a root the negated size of its set.
+ *    Packing the size into the parent word keeps one int per element, so `find` touches
+ *    a single array and never loads a separate rank or size field.
+ * `find` is iterative with path halving (every visited node is relinked to its grandparent),
+ * so there is no recursion however deep a tree is before it gets compressed.
+ */
+class DisjointSet {
+private:
+    std::vector<int> parent;
+
+public:
+    // Constructor: n singleton sets
+    explicit DisjointSet(int n) : parent(n, -1) {}
+
+    // Function to get the number of elements
+    int size() const {
+        return parent.size();
+    }
+
+    // Function to find the root of the set containing x
+    int find(int x) {
+        while (parent[x] >= 0) {
+            int p = parent[x];
+            int grandparent = parent[p];
+            if (grandparent < 0) {
+                return p;
+            }
+            parent[x] = grandparent; // Path halving
+            x = grandparent;
+        }
+        return x;
+    }
+
+    // Function to merge the sets of x and y (union by size); returns false if already merged
+    bool unite(int x, int y) {
+        x = find(x);
+        y = find(y);
+        if (x == y) {
+            return false;
+        }
+        if (parent[x] > parent[y]) {
+            std::swap(x, y); // x is now the root of the larger set
+        }
+        parent[x] += parent[y];
+        parent[y] = x;
+        return true;
+    }
+
+    // Function to check whether x and y are in the same set
+    bool connected(int x, int y) {
+        return find(x) == find(y);
+    }
+
+    // Function to get the size of the set containing x
+    int setSize(int x) {
+        return -parent[find(x)];
+    }
+
+    /*
+     * Function to merge a batch of pairs.
+     * The pairs are first grouped by the block of 1024 elements their smaller element falls
+     * in (a counting sort, so O(k + n / 1024)), so consecutive operations touch nearby parts
+     * of the array. The resulting sets do not depend on the order.
+     * Returns the number of merges performed.
+     */
+    int uniteMany(const std::vector<std::pair<int, int>>& pairs) {
+        const int BLOCK_SHIFT = 10;
+        std::vector<size_t> start((parent.size() >> BLOCK_SHIFT) + 2, 0);
+        for (const std::pair<int, int>& p : pairs) {
+            start[(std::min(p.first, p.second) >> BLOCK_SHIFT) + 1]++;
+        }
+        for (size_t b = 1; b < start.size(); b++) {
+            start[b] += start[b - 1];
+        }
+        std::vector<std::pair<int, int>> grouped(pairs.size());
+        for (const std::pair<int, int>& p : pairs) {
+            grouped[start[std::min(p.first, p.second) >> BLOCK_SHIFT]++] = p;
+        }
+
+        int merges = 0;
+        for (const std::pair<int, int>& p : grouped) {
+            if (unite(p.first, p.second)) merges++;
+        }
+        return merges;
+    }
+};
+
+/*
+ * Lock-free disjoint set for concurrent use.
+ * Contains:
+ *  - `parent`: Atomic parent pointers; a root points to itself.
+ * `find` shortens paths by halving with compare-and-swap (a failed CAS only means another
+ * thread already changed that link). `unite` links one root under the other with a single
+ * CAS, always linking the root of lower priority, so no cycle can form between threads.
+ * Linking by a fixed pseudo-random priority keeps trees shallow without a size field that
+ * would have to change atomically together with the link.
+ */
+class ConcurrentDisjointSet {
+private:
+    std::vector<std::atomic<int>> parent;
+
+    static unsigned priority(int x) {
+        unsigned h = x * 2654435761u;
+        return h ^ (h >> 16);
+    }
+
+    static bool lowerPriority(int x, int y) {
+        unsigned px = priority(x), py = priority(y);
+        return px < py || (px == py && x < y);
+    }
+
+public:
+    explicit ConcurrentDisjointSet(int n) : parent(n) {
+        for (int i = 0; i < n; i++) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    int size() const {
+        return parent.size();
+    }
+
+    // Function to find the root of the set containing x
+    int find(int x) {
+        while (true) {
+            int p = parent[x].load(std::memory_order_acquire);
+            if (p == x) return x;
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (p != grandparent) {
+                parent[x].compare_exchange_weak(p, grandparent, std::memory_order_acq_rel);
+            }
+            x = grandparent;
+        }
+    }
+
+    // Function to merge the sets of x and y; returns false if they were already merged
+    bool unite(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y) return false;
+            if (lowerPriority(y, x)) std::swap(x, y);
+            int expected = x;
+            if (parent[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    // Function to check whether x and y are in the same set, also while other threads unite
+    bool connected(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y) return true;
+            // x is still a root, so the answer held at the moment y's root was read
+            if (parent[x].load(std::memory_order_acquire) == x) return false;
+        }
+    }
+};
+
+} // namespace mst
+
+#endif
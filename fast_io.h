@@ -0,0 +1,374 @@
+#ifndef FAST_IO_H
+#define FAST_IO_H
+
+#include <string>
+#include <vector>
+#include <charconv>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * Fast input and output for the command-line drivers.
+ * Contains:
+ *  - `FastReader`: Whitespace-separated integers and words, or whole lines, from a file or
+ *    standard input. A regular file is memory-mapped and parsed in place; a pipe or terminal
+ *    is read in blocks of FAST_IO_BUFFER bytes. Integers are converted with std::from_chars,
+ *    which does not allocate, lock a stream or consult the locale as `cin >>` does.
+ *  - `FastWriter`: Buffered output to a file descriptor, with integers formatted by
+ *    std::to_chars. Prompts are written (and flushed) only in interactive mode.
+ *  - `readEdge`: Reads one `src dest weight` edge into any edge struct and checks its vertices.
+ *  - `parseDriverOptions`: The common command line of the drivers, `--batch [file]`.
+ * Malformed input throws runtime_error; a value that is missing at the end of the input
+ * throws runtime_error("unexpected end of input").
+ */
+namespace fast_io {
+
+// Size of the read buffer for pipes and terminals, and of the write buffer
+const size_t FAST_IO_BUFFER = 1 << 20;
+
+// Function to test for the whitespace characters of isspace in the "C" locale
+inline bool isSpace(char c) {
+    return c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t';
+}
+
+class FastReader {
+private:
+    int fd;
+    char* mapped;       // The whole file, for a regular file
+    size_t mappedBytes;
+    std::vector<char> buffer;
+    const char* pos;    // Next unread byte
+    const char* end;    // End of the bytes read so far
+    bool finished;      // True once the whole input is in [pos, end)
+
+    /*
+     * Function to read more input behind the unread bytes [pos, end), which are first moved
+     * to the front of the buffer (the buffer doubles if they fill it, e.g. for a long line).
+     * Returns false at end of input.
+     */
+    bool refill() {
+        if (finished) {
+            return false;
+        }
+        size_t unread = end - pos;
+        memmove(buffer.data(), pos, unread);
+        if (unread == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t got;
+        do {
+            got = ::read(fd, buffer.data() + unread, buffer.size() - unread);
+        } while (got < 0 && errno == EINTR);
+        if (got < 0) {
+            throw std::runtime_error(std::string("read failed: ") + strerror(errno));
+        }
+        pos = buffer.data();
+        end = pos + unread + got;
+        finished = (got == 0);
+        return got > 0;
+    }
+
+    // Function to skip whitespace; returns false at end of input
+    bool skipSpace() {
+        while (true) {
+            while (pos < end && isSpace(*pos)) {
+                pos++;
+            }
+            if (pos < end) {
+                return true;
+            }
+            if (!refill()) {
+                return false;
+            }
+        }
+    }
+
+    // Function to get the end of the token at `pos`, reading more input until it is complete
+    const char* tokenEnd() {
+        size_t length = 0;
+        while (true) {
+            const char* p = pos + length;
+            while (p < end && !isSpace(*p)) {
+                p++;
+            }
+            length = p - pos;
+            if (p < end || !refill()) {
+                return pos + length;
+            }
+        }
+    }
+
+public:
+    // Constructor: opens a file, or standard input if the path is "-"; throws runtime_error on failure
+    explicit FastReader(const std::string& path = "-")
+        : fd(STDIN_FILENO), mapped(nullptr), mappedBytes(0), pos(nullptr), end(nullptr), finished(false) {
+        if (path != "-") {
+            fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("cannot open " + path + ": " + strerror(errno));
+            }
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void* file = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (file != MAP_FAILED) {
+                madvise(file, info.st_size, MADV_SEQUENTIAL);
+                mapped = (char*)file;
+                mappedBytes = info.st_size;
+                pos = mapped;
+                end = mapped + mappedBytes;
+                finished = true;
+                return;
+            }
+        }
+        buffer.resize(FAST_IO_BUFFER);
+        pos = end = buffer.data();
+    }
+
+    ~FastReader() {
+        if (mapped != nullptr) munmap(mapped, mappedBytes);
+        if (fd != STDIN_FILENO) close(fd);
+    }
+
+    FastReader(const FastReader&) = delete;
+    FastReader& operator=(const FastReader&) = delete;
+
+    // Function to read one integer; returns false at end of input, throws runtime_error if it is malformed
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_integral<T>::value, "FastReader reads integers");
+        if (!skipSpace()) {
+            return false;
+        }
+        const char* last = tokenEnd();
+        std::from_chars_result result = std::from_chars(pos, last, value);
+        if (result.ec != std::errc() || result.ptr != last) {
+            throw std::runtime_error("invalid number \"" + std::string(pos, last) + "\"");
+        }
+        pos = last;
+        return true;
+    }
+
+    // Function to read several integers; returns false at end of input before the first one
+    template <typename T, typename U, typename... Rest>
+    bool read(T& first, U& second, Rest&... rest) {
+        if (!read(first)) {
+            return false;
+        }
+        if (!read(second, rest...)) {
+            throw std::runtime_error("unexpected end of input");
+        }
+        return true;
+    }
+
+    // Function to read one integer, throwing runtime_error at end of input
+    template <typename T>
+    T next() {
+        T value;
+        if (!read(value)) {
+            throw std::runtime_error("unexpected end of input");
+        }
+        return value;
+    }
+
+    // Function to read one whitespace-separated word; returns false at end of input
+    bool word(std::string& value) {
+        if (!skipSpace()) {
+            return false;
+        }
+        const char* last = tokenEnd();
+        value.assign(pos, last);
+        pos = last;
+        return true;
+    }
+
+    // Function to read one word, throwing runtime_error at end of input
+    std::string nextWord() {
+        std::string value;
+        if (!word(value)) {
+            throw std::runtime_error("unexpected end of input");
+        }
+        return value;
+    }
+
+    /*
+     * Function to read the rest of the current line, without the line break (\n or \r\n).
+     * Returns false only at end of input; a last line without a line break is still returned.
+     */
+    bool line(std::string& value) {
+        size_t length = 0;
+        const char* newline;
+        while ((newline = (const char*)memchr(pos + length, '\n', end - pos - length)) == nullptr) {
+            length = end - pos;
+            if (!refill()) {
+                if (length == 0) {
+                    return false;
+                }
+                newline = end;
+                break;
+            }
+        }
+        const char* last = newline;
+        if (last > pos && *(last - 1) == '\r') {
+            last--;
+        }
+        value.assign(pos, last);
+        pos = (newline == end) ? end : newline + 1;
+        return true;
+    }
+
+    // Function to read one line, throwing runtime_error at end of input
+    std::string nextLine() {
+        std::string value;
+        if (!line(value)) {
+            throw std::runtime_error("unexpected end of input");
+        }
+        return value;
+    }
+};
+
+class FastWriter {
+private:
+    int fd;
+    bool interactive;
+    std::vector<char> buffer;
+    size_t used;
+
+    // Function to make room for `bytes` more bytes in the buffer
+    void reserve(size_t bytes) {
+        if (used + bytes > buffer.size()) {
+            flush();
+            if (bytes > buffer.size()) {
+                buffer.resize(bytes);
+            }
+        }
+    }
+
+public:
+    // Constructor: `interactive` enables prompts; output goes to `fd` (standard output by default)
+    explicit FastWriter(bool _interactive = false, int _fd = STDOUT_FILENO)
+        : fd(_fd), interactive(_interactive), buffer(FAST_IO_BUFFER), used(0) {}
+
+    // Destructor: writes out what is left; errors are ignored here, call flush to see them
+    ~FastWriter() {
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+
+    FastWriter(const FastWriter&) = delete;
+    FastWriter& operator=(const FastWriter&) = delete;
+
+    // Function to write out everything buffered; throws runtime_error on failure
+    void flush() {
+        size_t done = 0;
+        while (done < used) {
+            ssize_t wrote = ::write(fd, buffer.data() + done, used - done);
+            if (wrote < 0 && errno == EINTR) continue;
+            if (wrote < 0) {
+                used = 0;
+                throw std::runtime_error(std::string("write failed: ") + strerror(errno));
+            }
+            done += wrote;
+        }
+        used = 0;
+    }
+
+    // Function to show a prompt before reading an answer; does nothing in batch mode
+    void prompt(const std::string& text) {
+        if (interactive) {
+            *this << text;
+            flush();
+        }
+    }
+
+    bool isInteractive() const {
+        return interactive;
+    }
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    FastWriter& operator<<(T value) {
+        reserve(24);
+        std::to_chars_result result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+        used = result.ptr - buffer.data();
+        return *this;
+    }
+
+    FastWriter& operator<<(char c) {
+        reserve(1);
+        buffer[used++] = c;
+        return *this;
+    }
+
+    FastWriter& operator<<(const char* text) {
+        size_t length = strlen(text);
+        reserve(length);
+        memcpy(buffer.data() + used, text, length);
+        used += length;
+        return *this;
+    }
+
+    FastWriter& operator<<(const std::string& text) {
+        reserve(text.size());
+        memcpy(buffer.data() + used, text.data(), text.size());
+        used += text.size();
+        return *this;
+    }
+};
+
+/*
+ * Function to read one edge `src dest weight` into any struct with those int members.
+ * Returns false at end of input; throws out_of_range if a vertex is not in 0 .. V-1.
+ */
+template <typename Edge>
+bool readEdge(FastReader& in, int V, Edge& edge) {
+    int src, dest, weight;
+    if (!in.read(src, dest, weight)) {
+        return false;
+    }
+    if (src < 0 || src >= V || dest < 0 || dest >= V) {
+        throw std::out_of_range("edge " + std::to_string(src) + " " + std::to_string(dest) +
+                                " has a vertex outside 0.." + std::to_string(V - 1));
+    }
+    edge = Edge{src, dest, weight};
+    return true;
+}
+
+/*
+ * Options shared by the drivers.
+ * Contains:
+ *  - `batch`: No prompts; the answers are read from `input` as whitespace-separated values
+ *    in the order the prompts would ask for them.
+ *  - `input`: Input file, "-" for standard input.
+ */
+struct DriverOptions {
+    bool batch;
+    std::string input;
+};
+
+// Function to parse `--batch [file]`; with no arguments the driver runs interactively on standard input
+inline DriverOptions parseDriverOptions(int argc, char* argv[]) {
+    DriverOptions options = {false, "-"};
+    if (argc >= 2 && std::string(argv[1]) == "--batch") {
+        options.batch = true;
+        if (argc >= 3) {
+            options.input = argv[2];
+        }
+    } else if (argc >= 2) {
+        throw std::invalid_argument(std::string("unknown option ") + argv[1] + " (usage: " + argv[0] +
+                                    " [--batch [file]])");
+    }
+    return options;
+}
+
+} // namespace fast_io
+
+#endif
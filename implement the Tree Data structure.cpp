@@ -1,118 +1,51 @@
 #include <iostream>
+#include <stdexcept>
+#include "binary_search_tree.h"
+#include "fast_io.h"
 using namespace std;
+using namespace bst;
+using namespace fast_io;
+
+int main(int argc, char* argv[]) {
+    try {
+        DriverOptions options = parseDriverOptions(argc, argv);
+        FastReader in(options.input);
+        FastWriter out(!options.batch);
+        BinarySearchTree tree;
+        int choice;
+
+        out.prompt("Binary Search Tree Operations:\n1. Insert\n2. Search\n3. Exit\n");
+
+        while (true) {
+            out.prompt("Enter your choice: ");
+            // In batch mode the end of the input ends the program like choice 3
+            if (!in.read(choice)) {
+                if (options.batch) break;
+                throw runtime_error("unexpected end of input");
+            }
 
-/*
- * Node structure for the Binary Search Tree (BST).
- * Contains:
- *  - `data`: The value stored in the node.
- *  - `left`: Pointer to the left child.
- *  - `right`: Pointer to the right child.
- */
-struct Node {
-    int data;
-    Node* left;
-    Node* right;
-
-    // Constructor to initialize a new node
-    Node(int value) {
-        data = value;
-        left = nullptr;
-        right = nullptr;
-    }
-};
-
-/*
- * Class representing the Binary Search Tree.
- * Contains:
- *  - `insert`: Function to insert a new node.
- *  - `search`: Function to search for a value in the tree.
- */
-class BinarySearchTree {
-private:
-    Node* root; // Root node of the tree
-
-    // Helper function for insertion
-    Node* insertHelper(Node* node, int value) {
-        if (node == nullptr) {
-            return new Node(value); // Create a new node if position is found
-        }
-
-        // Recursively insert in the left or right subtree
-        if (value < node->data) {
-            node->left = insertHelper(node->left, value);
-        } else if (value > node->data) {
-            node->right = insertHelper(node->right, value);
-        }
-
-        return node;
-    }
-
-    // Helper function for searching
-    bool searchHelper(Node* node, int value) {
-        if (node == nullptr) {
-            return false; // Value not found
-        }
-
-        if (node->data == value) {
-            return true; // Value found
-        } else if (value < node->data) {
-            return searchHelper(node->left, value); // Search in the left subtree
-        } else {
-            return searchHelper(node->right, value); // Search in the right subtree
-        }
-    }
-
-public:
-    // Constructor to initialize the tree
-    BinarySearchTree() {
-        root = nullptr;
-    }
-
-    // Public function to insert a value
-    void insert(int value) {
-        root = insertHelper(root, value);
-    }
-
-    // Public function to search for a value
-    bool search(int value) {
-        return searchHelper(root, value);
-    }
-};
-
-int main() {
-    BinarySearchTree bst;
-    int choice;
-
-    cout << "Binary Search Tree Operations:" << endl;
-    cout << "1. Insert" << endl;
-    cout << "2. Search" << endl;
-    cout << "3. Exit" << endl;
-
-    while (true) {
-        cout << "Enter your choice: ";
-        cin >> choice;
-
-        if (choice == 1) {
-            int value;
-            cout << "Enter the value to insert: ";
-            cin >> value;
-            bst.insert(value);
-            cout << "Value inserted successfully!" << endl;
-        } else if (choice == 2) {
-            int value;
-            cout << "Enter the value to search: ";
-            cin >> value;
-            if (bst.search(value)) {
-                cout << "Value found in the tree!" << endl;
+            if (choice == 1) {
+                out.prompt("Enter the value to insert: ");
+                tree.insert(in.next<int>());
+                out << "Value inserted successfully!\n";
+            } else if (choice == 2) {
+                out.prompt("Enter the value to search: ");
+                if (tree.search(in.next<int>())) {
+                    out << "Value found in the tree!\n";
+                } else {
+                    out << "Value not found in the tree!\n";
+                }
+            } else if (choice == 3) {
+                out << "Exiting the program.\n";
+                break;
             } else {
-                cout << "Value not found in the tree!" << endl;
+                out << "Invalid choice. Please try again.\n";
             }
-        } else if (choice == 3) {
-            cout << "Exiting the program." << endl;
-            break;
-        } else {
-            cout << "Invalid choice. Please try again." << endl;
         }
+        out.flush();
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
     }
 
     return 0;
@@ -128,16 +61,19 @@ int main() {
  *
  * Key Concepts:
  *  - Insertion:
- *      * Recursively finds the correct position for the new value.
+ *      * Walks down from the root to the empty position where the new value belongs.
  *      * Values smaller than the current node go to the left subtree.
  *      * Values larger than the current node go to the right subtree.
  *  - Searching:
- *      * Recursively compares the search value with the current node.
+ *      * Compares the search value with the current node and moves to one of its subtrees.
  *      * Terminates if the value is found or if the subtree becomes empty.
+ *  - The tree is `BinarySearchTree` in binary_search_tree.h.
  *
  * Input:
  *  - The user interacts with the program through a menu.
  *  - Choices: Insert a value, search for a value, or exit the program.
+ *  - With `--batch [file]` the choices and values are read without prompts from the file (or
+ *    from standard input); the end of the input also exits.
  *
  * Output:
  *  - Confirmation of insertion.
@@ -148,7 +84,7 @@ int main() {
  *     * Insertion: O(h), where h is the height of the tree.
  *     * Search: O(h), where h is the height of the tree.
  *     * In a balanced tree, h = O(log n), where n is the number of nodes.
- *  - Space Complexity: O(h) for recursive calls.
+ *  - Space Complexity: O(1) besides the nodes, since both operations are loops.
  *
  * Example:
  *  - Input:
@@ -0,0 +1,86 @@
+#ifndef KMP_H
+#define KMP_H
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+/*
+ * The Knuth-Morris-Pratt algorithm.
+ * Contains:
+ *  - `computeLPSArray`: The longest proper prefix of the pattern that is also a suffix, for
+ *    every prefix of the pattern.
+ *  - `KMPfindAll`: All occurrences of a pattern in a text in O(n + m).
+ * The faster engines built on the LPS array are in kmp_automaton.h and kmp_prefilter.h.
+ */
+namespace kmp {
+
+/*
+ * Function to compute the Longest Prefix Suffix (LPS) array.
+ * The LPS array helps avoid redundant comparisons in the KMP algorithm.
+ */
+inline void computeLPSArray(const std::string& pattern, std::vector<int>& lps) {
+    int length = 0; // Length of the previous longest prefix suffix
+    int i = 1;
+    lps[0] = 0; // lps[0] is always 0
+
+    // Loop through the pattern to fill the LPS array
+    while (i < (int)pattern.size()) {
+        if (pattern[i] == pattern[length]) {
+            length++;
+            lps[i] = length;
+            i++;
+        } else {
+            if (length != 0) {
+                length = lps[length - 1]; // Backtrack
+            } else {
+                lps[i] = 0;
+                i++;
+            }
+        }
+    }
+}
+
+/*
+ * Function to implement the KMP algorithm for pattern searching.
+ * It returns the starting indices of all occurrences of the pattern in the text.
+ */
+inline std::vector<int> KMPfindAll(const std::string& text, const std::string& pattern) {
+    int n = text.size();
+    int m = pattern.size();
+    if (m == 0) {
+        throw std::invalid_argument("The pattern must not be empty");
+    }
+
+    // Step 1: Compute the LPS array
+    std::vector<int> lps(m);
+    computeLPSArray(pattern, lps);
+
+    int i = 0; // Index for text
+    int j = 0; // Index for pattern
+
+    std::vector<int> matches;
+    while (i < n) {
+        if (pattern[j] == text[i]) {
+            i++;
+            j++;
+        }
+
+        if (j == m) {
+            // Pattern found, record the starting index
+            matches.push_back(i - j);
+            j = lps[j - 1];
+        } else if (i < n && pattern[j] != text[i]) {
+            if (j != 0) {
+                j = lps[j - 1]; // Use LPS to skip unnecessary comparisons
+            } else {
+                i++;
+            }
+        }
+    }
+    return matches;
+}
+
+} // namespace kmp
+
+#endif
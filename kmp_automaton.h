@@ -0,0 +1,171 @@
+#ifndef KMP_AUTOMATON_H
+#define KMP_AUTOMATON_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+#include "streaming_kmp.h"
+
+/*
+ * Exact matchers without the fallback loop of KMP.
+ * Contains:
+ *  - `KMPAutomaton`: The LPS array compiled into a full DFA. Row j of the table gives, for
+ *    every byte, the number of pattern characters matched after reading that byte with j
+ *    already matched. Each row is built from the row lps[j - 1] computed before it, so all
+ *    fallbacks happen once at build time and the search is one table lookup per byte.
+ *  - `ShiftOr`: Bit-parallel matching (Baeza-Yates/Gonnet) for patterns of up to 64 bytes.
+ *    Bit i of the state is 0 while the last i + 1 text bytes equal the first i + 1 pattern
+ *    bytes; each byte costs one shift, one OR and one table lookup, with no branches except
+ *    the test for a match.
+ *  - `ExactMatcher`: Picks an engine by pattern length: Shift-Or up to 64 bytes, the DFA up
+ *    to 254, and the KMP loop beyond that.
+ */
+namespace kmp {
+
+class KMPAutomaton {
+public:
+    // States fit in a byte, which keeps the table at (m + 1) * 256 bytes
+    static const size_t MAX_PATTERN = 254;
+
+private:
+    size_t m;
+    std::vector<uint8_t> next; // next[j * 256 + c]: the state after byte c in state j
+
+public:
+    // Constructor: builds the DFA; throws invalid_argument for an empty pattern, length_error if too long
+    explicit KMPAutomaton(const std::string& pattern) : m(pattern.size()) {
+        if (m == 0) {
+            throw std::invalid_argument("The pattern must not be empty");
+        }
+        if (m > MAX_PATTERN) {
+            throw std::length_error("KMPAutomaton supports patterns of up to 254 bytes");
+        }
+        std::vector<int> lps = buildLPS(pattern);
+        next.assign((m + 1) * 256, 0);
+        for (size_t j = 0; j <= m; j++) {
+            for (int c = 0; c < 256; c++) {
+                if (j < m && (unsigned char)pattern[j] == c) {
+                    next[j * 256 + c] = j + 1;
+                } else if (j > 0) {
+                    next[j * 256 + c] = next[lps[j - 1] * 256 + c]; // Where the KMP loop would fall back to
+                }
+            }
+        }
+    }
+
+    // Function to call onMatch(position) for every occurrence of the pattern in text[0 .. n), in order
+    template <typename OnMatch>
+    void search(const char* text, size_t n, OnMatch onMatch) const {
+        const uint8_t* table = next.data();
+        unsigned state = 0;
+        for (size_t i = 0; i < n; i++) {
+            state = table[(state << 8) | (unsigned char)text[i]];
+            if (state == m) {
+                onMatch(i + 1 - m);
+            }
+        }
+    }
+
+    size_t tableBytes() const {
+        return next.size();
+    }
+};
+
+class ShiftOr {
+public:
+    static const size_t MAX_PATTERN = 64;
+
+private:
+    size_t m;
+    uint64_t masks[256]; // Bit i of masks[c] is 0 if pattern[i] == c
+    uint64_t matchBit;
+
+public:
+    // Constructor: builds the masks; throws invalid_argument for an empty pattern, length_error if too long
+    explicit ShiftOr(const std::string& pattern) : m(pattern.size()) {
+        if (m == 0) {
+            throw std::invalid_argument("The pattern must not be empty");
+        }
+        if (m > MAX_PATTERN) {
+            throw std::length_error("Shift-Or supports patterns of up to 64 bytes");
+        }
+        for (int c = 0; c < 256; c++) {
+            masks[c] = ~0ULL;
+        }
+        for (size_t i = 0; i < m; i++) {
+            masks[(unsigned char)pattern[i]] &= ~(1ULL << i);
+        }
+        matchBit = 1ULL << (m - 1);
+    }
+
+    // Function to call onMatch(position) for every occurrence of the pattern in text[0 .. n), in order
+    template <typename OnMatch>
+    void search(const char* text, size_t n, OnMatch onMatch) const {
+        uint64_t state = ~0ULL;
+        for (size_t i = 0; i < n; i++) {
+            state = (state << 1) | masks[(unsigned char)text[i]];
+            if ((state & matchBit) == 0) {
+                onMatch(i + 1 - m);
+            }
+        }
+    }
+};
+
+enum MatchEngine { ENGINE_SHIFT_OR, ENGINE_DFA, ENGINE_KMP_LOOP };
+
+class ExactMatcher {
+private:
+    MatchEngine engine;
+    std::unique_ptr<ShiftOr> shiftOr;
+    std::unique_ptr<KMPAutomaton> automaton;
+    std::unique_ptr<StreamingKMP> loop;
+
+public:
+    // Constructor: picks the engine for the pattern length; throws invalid_argument for an empty pattern
+    explicit ExactMatcher(const std::string& pattern) {
+        if (pattern.size() <= ShiftOr::MAX_PATTERN) {
+            engine = ENGINE_SHIFT_OR;
+            shiftOr.reset(new ShiftOr(pattern));
+        } else if (pattern.size() <= KMPAutomaton::MAX_PATTERN) {
+            engine = ENGINE_DFA;
+            automaton.reset(new KMPAutomaton(pattern));
+        } else {
+            engine = ENGINE_KMP_LOOP;
+            loop.reset(new StreamingKMP(pattern));
+        }
+    }
+
+    // Function to call onMatch(position) for every occurrence of the pattern in text[0 .. n), in order
+    template <typename OnMatch>
+    void search(const char* text, size_t n, OnMatch onMatch) const {
+        if (engine == ENGINE_SHIFT_OR) {
+            shiftOr->search(text, n, onMatch);
+        } else if (engine == ENGINE_DFA) {
+            automaton->search(text, n, onMatch);
+        } else {
+            StreamingKMP matcher = *loop;
+            matcher.feed(text, n, [&](uint64_t position) { onMatch(position); });
+        }
+    }
+
+    // Function to get the starting indices of all occurrences of the pattern in the text
+    std::vector<size_t> findAll(const std::string& text) const {
+        std::vector<size_t> matches;
+        search(text.data(), text.size(), [&](size_t position) { matches.push_back(position); });
+        return matches;
+    }
+
+    MatchEngine getEngine() const {
+        return engine;
+    }
+
+    const char* engineName() const {
+        return engine == ENGINE_SHIFT_OR ? "Shift-Or" : (engine == ENGINE_DFA ? "DFA" : "KMP loop");
+    }
+};
+
+} // namespace kmp
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef KMP_PREFILTER_H
+#define KMP_PREFILTER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "kmp_automaton.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define KMP_PREFILTER_X86 1
+#endif
+
+/*
+ * KMP search with a SIMD candidate prefilter.
+ * Two anchor bytes of the pattern are compared against 32 (AVX2) or 64 (AVX-512) text
+ * positions at once: position s is a candidate only if text[s + first] and text[s + second]
+ * both equal the pattern bytes at those offsets. Candidates are verified by comparing the
+ * whole pattern. For a rare pattern almost every block of text is rejected with a few vector
+ * instructions, instead of one KMP step per byte.
+ * Each candidate is charged the m bytes its verification may compare. Once the charge exceeds
+ * the bytes scanned so far (plus a 4 KB allowance), e.g. for "aaab" in a run of 'a's or a long
+ * periodic pattern, the search switches to `ExactMatcher` (kmp_automaton.h: Shift-Or, the KMP
+ * DFA or the KMP loop) for the rest of the text. Verification therefore compares O(n + m)
+ * bytes in total, and the search stays O(n + m). The same matcher is the path on CPUs without AVX2.
+ * The instruction set is chosen at run time, so no special compiler flags are needed.
+ */
+namespace kmp {
+
+// Instruction sets of the prefilter, in increasing order
+enum PrefilterISA { PREFILTER_SCALAR, PREFILTER_AVX2, PREFILTER_AVX512 };
+
+// Which anchor bytes the prefilter compares
+enum PrefilterAnchors { ANCHOR_FIRST_LAST, ANCHOR_RARE_BYTES };
+
+/*
+ * Function to estimate how common a byte is in text and logs (higher is more common).
+ * Only the order matters: it is used to pick the rarest bytes of a pattern as anchors.
+ */
+inline int byteFrequency(unsigned char c) {
+    static const char* lowercaseByFrequency = "etaoinsrhldcumfpgwybvkxjqz";
+    if (c == ' ') return 255;
+    if (c >= 'a' && c <= 'z') return 250 - (int)(strchr(lowercaseByFrequency, c) - lowercaseByFrequency);
+    if (c >= '0' && c <= '9') return 200;
+    if (strchr(".,-:/_=\n\"'()[]", c) != nullptr && c != 0) return 180;
+    if (c >= 'A' && c <= 'Z') return 160 - (int)(strchr(lowercaseByFrequency, c - 'A' + 'a') - lowercaseByFrequency);
+    if (c >= 32 && c < 127) return 100;
+    if (c == '\t' || c == '\r') return 90;
+    return c >= 128 ? 20 : 10;
+}
+
+class PrefilteredKMP {
+private:
+    std::string pattern;
+    ExactMatcher exact;
+    size_t first, second; // Anchor offsets in the pattern, first <= second
+    PrefilterISA isa;
+
+    // Function to search text[start .. n) without the prefilter
+    template <typename OnMatch>
+    void searchExact(const char* text, size_t n, size_t start, OnMatch& onMatch) const {
+        exact.search(text + start, n - start, [&](size_t offset) { onMatch(start + offset); });
+    }
+
+    // Function to check the candidates from `start` on without SIMD (for the tail of the text)
+    template <typename OnMatch>
+    void searchTail(const char* text, size_t n, size_t start, OnMatch& onMatch) const {
+        size_t m = pattern.size();
+        for (size_t s = start; s + m <= n; s++) {
+            if (text[s + first] == pattern[first] && text[s + second] == pattern[second] &&
+                memcmp(text + s, pattern.data(), m) == 0) {
+                onMatch(s);
+            }
+        }
+    }
+
+    // Function to verify the candidates in a bit mask of positions block + 0 .. 63; returns the bytes charged (m each)
+    template <typename OnMatch>
+    size_t verify(const char* text, size_t n, size_t block, uint64_t mask, OnMatch& onMatch) const {
+        size_t m = pattern.size(), candidates = 0;
+        for (; mask != 0; mask &= mask - 1) {
+            size_t s = block + __builtin_ctzll(mask);
+            if (s + m <= n && memcmp(text + s, pattern.data(), m) == 0) {
+                onMatch(s);
+            }
+            candidates++;
+        }
+        return candidates * m;
+    }
+
+    // Verification bytes allowed before the position `s`, beyond which the exact matcher takes over
+    static size_t compareBudget(size_t s) {
+        return s + 4096;
+    }
+
+#ifdef KMP_PREFILTER_X86
+    // Function to scan 32 positions per step; returns where it stopped and whether candidates were dense
+    template <typename OnMatch>
+    __attribute__((target("avx2"))) size_t scanAVX2(const char* text, size_t n, bool& dense, OnMatch& onMatch) const {
+        const __m256i a = _mm256_set1_epi8(pattern[first]);
+        const __m256i b = _mm256_set1_epi8(pattern[second]);
+        size_t s = 0, compared = 0;
+        for (; s + second + 32 <= n; s += 32) {
+            if (compared > compareBudget(s)) {
+                dense = true;
+                return s;
+            }
+            __m256i x = _mm256_loadu_si256((const __m256i*)(text + s + first));
+            __m256i y = _mm256_loadu_si256((const __m256i*)(text + s + second));
+            uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(x, a), _mm256_cmpeq_epi8(y, b)));
+            if (mask != 0) {
+                compared += verify(text, n, s, mask, onMatch);
+            }
+        }
+        dense = false;
+        return s;
+    }
+
+    // Function to scan 64 positions per step; returns where it stopped and whether candidates were dense
+    template <typename OnMatch>
+    __attribute__((target("avx512f,avx512bw"))) size_t scanAVX512(const char* text, size_t n, bool& dense,
+                                                                  OnMatch& onMatch) const {
+        const __m512i a = _mm512_set1_epi8(pattern[first]);
+        const __m512i b = _mm512_set1_epi8(pattern[second]);
+        size_t s = 0, compared = 0;
+        for (; s + second + 64 <= n; s += 64) {
+            if (compared > compareBudget(s)) {
+                dense = true;
+                return s;
+            }
+            __m512i x = _mm512_loadu_si512((const void*)(text + s + first));
+            __m512i y = _mm512_loadu_si512((const void*)(text + s + second));
+            uint64_t mask = _mm512_cmpeq_epi8_mask(x, a) & _mm512_cmpeq_epi8_mask(y, b);
+            if (mask != 0) {
+                compared += verify(text, n, s, mask, onMatch);
+            }
+        }
+        dense = false;
+        return s;
+    }
+#endif
+
+public:
+    /*
+     * Constructor: picks the anchors (the first and last byte, or the two rarest bytes by
+     * `byteFrequency`) and the best instruction set supported by the CPU, up to `limit`.
+     * Throws invalid_argument for an empty pattern.
+     */
+    explicit PrefilteredKMP(const std::string& _pattern, PrefilterAnchors anchors = ANCHOR_RARE_BYTES,
+                            PrefilterISA limit = PREFILTER_AVX512)
+        : pattern(_pattern), exact(_pattern), first(0), second(_pattern.size() - 1), isa(PREFILTER_SCALAR) {
+        if (anchors == ANCHOR_RARE_BYTES && pattern.size() > 1) {
+            std::vector<size_t> order(pattern.size());
+            for (size_t i = 0; i < order.size(); i++) order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+                return byteFrequency(pattern[x]) < byteFrequency(pattern[y]);
+            });
+            // The rarest byte, and the rarest position holding a different byte if there is one
+            size_t other = order[1];
+            for (size_t i = 1; i < order.size(); i++) {
+                if (pattern[order[i]] != pattern[order[0]]) {
+                    other = order[i];
+                    break;
+                }
+            }
+            first = std::min(order[0], other);
+            second = std::max(order[0], other);
+        }
+#ifdef KMP_PREFILTER_X86
+        if (limit >= PREFILTER_AVX512 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            isa = PREFILTER_AVX512;
+        } else if (limit >= PREFILTER_AVX2 && __builtin_cpu_supports("avx2")) {
+            isa = PREFILTER_AVX2;
+        }
+#else
+        (void)limit;
+#endif
+    }
+
+    // Function to call onMatch(position) for every occurrence of the pattern in text[0 .. n), in order
+    template <typename OnMatch>
+    void search(const char* text, size_t n, OnMatch onMatch) const {
+        if (isa == PREFILTER_SCALAR) {
+            searchExact(text, n, 0, onMatch);
+            return;
+        }
+#ifdef KMP_PREFILTER_X86
+        bool dense = false;
+        size_t stop = (isa == PREFILTER_AVX512) ? scanAVX512(text, n, dense, onMatch) : scanAVX2(text, n, dense, onMatch);
+        if (dense) {
+            searchExact(text, n, stop, onMatch);
+        } else {
+            searchTail(text, n, stop, onMatch);
+        }
+#endif
+    }
+
+    // Function to get the starting indices of all occurrences of the pattern in the text
+    std::vector<size_t> findAll(const std::string& text) const {
+        std::vector<size_t> matches;
+        search(text.data(), text.size(), [&](size_t position) { matches.push_back(position); });
+        return matches;
+    }
+
+    PrefilterISA instructionSet() const {
+        return isa;
+    }
+
+    const char* instructionSetName() const {
+        return isa == PREFILTER_AVX512 ? "AVX-512" : (isa == PREFILTER_AVX2 ? "AVX2" : "scalar");
+    }
+
+    // Function to get the anchor offsets in the pattern
+    std::pair<size_t, size_t> anchors() const {
+        return {first, second};
+    }
+};
+
+} // namespace kmp
+
+#endif
@@ -1,129 +1,207 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <random>
+#include <thread>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "minimum_spanning_tree.h"
+#include "fast_io.h"
 using namespace std;
+using namespace mst;
+using namespace fast_io;
 
-/*
- * Structure to represent an edge of the graph.
- * Contains:
- *  - `src`: Source vertex
- *  - `dest`: Destination vertex
- *  - `weight`: Weight of the edge
- */
-struct Edge {
-    int src, dest, weight;
-};
+// Function to run one weight model of the density sweep (see densitySweepBenchmark)
+void densitySweep(int V, bool filterResistant) {
+    cout << "Density  Edges       Kruskal  Filter   HeapPrim ArrayPrim Boruvka  Auto     (choice)" << endl;
+    for (double density : {0.001, 0.003, 0.01, 0.03, 0.1, 0.25, 0.5, 1.0}) {
+        mt19937 rng(12345);
+        uniform_int_distribution<int> noise(0, 1000000);
+        auto weights = [&](int u, int v) {
+            return filterResistant ? max(u, v) * 1000 + noise(rng) % 1000 : noise(rng);
+        };
+        vector<Edge> edges;
+        if (density >= 0.25) {
+            // Dense: keep each vertex pair with probability `density`
+            uniform_real_distribution<double> coin(0, 1);
+            for (int u = 0; u < V; u++) {
+                for (int v = u + 1; v < V; v++) {
+                    if (coin(rng) < density) edges.push_back({u, v, weights(u, v)});
+                }
+            }
+        } else {
+            long long E = density * V * (V - 1) / 2;
+            for (long long i = 0; i < E; i++) {
+                int u = rng() % V, v = rng() % V;
+                edges.push_back({u, v, weights(u, v)});
+            }
+        }
 
-/*
- * Structure to represent a subset for union-find.
- * Contains:
- *  - `parent`: Parent of the subset
- *  - `rank`: Rank of the subset
- */
-struct Subset {
-    int parent, rank;
-};
+        vector<double> times;
+        vector<long long> totals;
+        const char* choice = nullptr;
+        for (int algorithm = 0; algorithm < 6; algorithm++) {
+            vector<Edge> copy = edges;
+            vector<Edge> mst;
+            auto start = chrono::steady_clock::now();
+            if (algorithm == 0) mst = kruskalMST(copy, V);
+            else if (algorithm == 1) mst = filterKruskalMST(copy, V);
+            else if (algorithm == 2) mst = heapPrimMST(copy, V);
+            else if (algorithm == 3) mst = arrayPrimMST(copy, V);
+            else if (algorithm == 4) mst = parallelBoruvkaMST(copy, V, thread::hardware_concurrency());
+            else choice = autoMST(copy, V, mst);
+            times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
 
-/*
- * Function to find the parent of an element in the union-find data structure.
- * Implements path compression for efficiency.
- * Parameters:
- *  - subsets: Vector of subsets
- *  - i: Element to find the parent for
- * Returns:
- *  - Parent of the element `i`.
- */
-int find(vector<Subset>& subsets, int i) {
-    if (subsets[i].parent != i) {
-        subsets[i].parent = find(subsets, subsets[i].parent);
+            long long total = 0;
+            for (const Edge& e : mst) total += e.weight;
+            totals.push_back(total);
+        }
+
+        printf("%-8.3f %-11zu", density, edges.size());
+        for (double t : times) printf(" %-8.1f", t);
+        printf(" (%s)\n", choice);
+        for (long long total : totals) {
+            if (total != totals[0]) {
+                cout << "Error: the algorithms disagree on the MST weight!" << endl;
+                return;
+            }
+        }
     }
-    return subsets[i].parent;
 }
 
 /*
- * Function to perform union of two subsets.
- * Implements union by rank for efficiency.
- * Parameters:
- *  - subsets: Vector of subsets
- *  - x: First subset
- *  - y: Second subset
+ * Density sweep benchmark.
+ * Times every MST algorithm on random graphs with V vertices at densities from 0.1% to 100%
+ * of all vertex pairs, checks that they agree on the total weight and prints the times in ms,
+ * which shows where the crossover points between the algorithms are.
+ * Two weight models are swept:
+ *  - uniform: independent random weights, the best case for Filter-Kruskal's filtering.
+ *  - filter-resistant: the weight grows with the larger endpoint, so after the light edges
+ *    are added no heavy edge joins two connected vertices and Filter-Kruskal sorts everything.
  */
-void unionSubsets(vector<Subset>& subsets, int x, int y) {
-    int rootX = find(subsets, x);
-    int rootY = find(subsets, y);
-
-    if (subsets[rootX].rank < subsets[rootY].rank) {
-        subsets[rootX].parent = rootY;
-    } else if (subsets[rootX].rank > subsets[rootY].rank) {
-        subsets[rootY].parent = rootX;
-    } else {
-        subsets[rootY].parent = rootX;
-        subsets[rootX].rank++;
+void densitySweepBenchmark(int V) {
+    for (bool filterResistant : {false, true}) {
+        cout << (filterResistant ? "\nFilter-resistant weights" : "Uniform weights") << endl;
+        densitySweep(V, filterResistant);
     }
 }
 
-/*
- * Function to compare two edges by weight.
- * Used for sorting edges in ascending order.
- */
-bool compareEdges(const Edge& e1, const Edge& e2) {
-    return e1.weight < e2.weight;
-}
+int main(int argc, char* argv[]) {
+    try {
+        DriverOptions options = parseDriverOptions(argc, argv);
+        FastReader in(options.input);
+        FastWriter out(!options.batch);
 
-int main() {
-    // Input number of vertices and edges
-    int V, E;
-    cout << "Enter the number of vertices: ";
-    cin >> V;
-    cout << "Enter the number of edges: ";
-    cin >> E;
-
-    // Input edges
-    vector<Edge> edges(E);
-    cout << "Enter the edges in the format (src dest weight):\n";
-    for (int i = 0; i < E; i++) {
-        cout << "Edge " << i + 1 << ": ";
-        cin >> edges[i].src >> edges[i].dest >> edges[i].weight;
-    }
+        // Choose the MST algorithm
+        out.prompt("MST algorithms:\n"
+                   "1. Kruskal (sort all edges)\n"
+                   "2. Filter-Kruskal\n"
+                   "3. Parallel Boruvka\n"
+                   "4. Streaming (edges inserted one at a time)\n"
+                   "5. Semi-external Kruskal (binary edge file)\n"
+                   "6. Prim (indexed 4-ary heap)\n"
+                   "7. Prim (array-based, for dense graphs)\n"
+                   "8. Automatic choice by density\n"
+                   "9. Density sweep benchmark\n"
+                   "Enter your choice: ");
+        int algorithm = in.next<int>();
+
+        if (algorithm < 1 || algorithm > 9) {
+            out << "Invalid choice.\n";
+            return 1;
+        }
 
-    // Sort edges in ascending order by weight
-    sort(edges.begin(), edges.end(), compareEdges);
+        // Input number of vertices
+        out.prompt("Enter the number of vertices: ");
+        int V = in.next<int>();
+        if (V < 1) {
+            throw invalid_argument("The graph needs at least one vertex");
+        }
 
-    // Create subsets for union-find
-    vector<Subset> subsets(V);
-    for (int v = 0; v < V; v++) {
-        subsets[v].parent = v;
-        subsets[v].rank = 0;
-    }
+        if (algorithm == 9) {
+            out.flush();
+            densitySweepBenchmark(V);
+            return 0;
+        }
 
-    // Vector to store the result MST
-    vector<Edge> mst;
+        // Vector to store the result MST
+        vector<Edge> mst;
+        const char* chosen = nullptr;
 
-    // Iterate through sorted edges and build MST
-    for (const Edge& edge : edges) {
-        int x = find(subsets, edge.src);
-        int y = find(subsets, edge.dest);
+        if (algorithm == 5) {
+            // The edges stay on disk
+            out.prompt("Enter the edge file (binary src dest weight ints): ");
+            string edgePath = in.nextWord();
+            out.prompt("Enter the memory budget in MB: ");
+            size_t memoryMB = in.next<size_t>();
+            out.prompt("Enter the temp directory: ");
+            string tempDir = in.nextWord();
+            try {
+                semiExternalKruskalMST(edgePath, V, memoryMB << 20, tempDir, mst);
+            } catch (const exception& e) {
+                out << "Semi-external MST failed: " << e.what() << '\n';
+                return 1;
+            }
+        } else {
+            // Input number of edges
+            out.prompt("Enter the number of edges: ");
+            int E = in.next<int>();
+            if (E < 0) {
+                throw invalid_argument("The number of edges must not be negative");
+            }
 
-        // If including this edge doesn't form a cycle
-        if (x != y) {
-            mst.push_back(edge);
-            unionSubsets(subsets, x, y);
-        }
+            // Input edges
+            vector<Edge> edges(E);
+            out.prompt("Enter the edges in the format (src dest weight):\n");
+            IncrementalMST stream(algorithm == 4 ? V : 0);
+            for (int i = 0; i < E; i++) {
+                out.prompt("Edge " + to_string(i + 1) + ": ");
+                if (!readEdge(in, V, edges[i])) {
+                    throw runtime_error("unexpected end of input");
+                }
+
+                // Streaming mode keeps the forest current as every edge arrives
+                if (algorithm == 4) {
+                    stream.insert(edges[i]);
+                    out << "(current MST weight: " << stream.weight() << ")\n";
+                }
+            }
 
-        // Stop if MST has V-1 edges
-        if (mst.size() == V - 1) {
-            break;
+            if (algorithm == 1) {
+                mst = kruskalMST(edges, V);
+            } else if (algorithm == 2) {
+                mst = filterKruskalMST(edges, V);
+            } else if (algorithm == 3) {
+                mst = parallelBoruvkaMST(edges, V, thread::hardware_concurrency());
+            } else if (algorithm == 4) {
+                mst = stream.edges();
+            } else if (algorithm == 6) {
+                mst = heapPrimMST(edges, V);
+            } else if (algorithm == 7) {
+                mst = arrayPrimMST(edges, V);
+            } else {
+                chosen = autoMST(edges, V, mst);
+            }
         }
-    }
 
-    // Display the MST
-    cout << "Minimum Spanning Tree (MST):\n";
-    int totalWeight = 0;
-    for (const Edge& edge : mst) {
-        cout << edge.src << " -- " << edge.dest << " == " << edge.weight << endl;
-        totalWeight += edge.weight;
+        // Display the MST
+        out << "Minimum Spanning Tree (MST):\n";
+        long long totalWeight = 0;
+        for (const Edge& edge : mst) {
+            out << edge.src << " -- " << edge.dest << " == " << edge.weight << '\n';
+            totalWeight += edge.weight;
+        }
+        out << "Total weight of MST: " << totalWeight << '\n';
+        if (chosen != nullptr) {
+            out << "Algorithm used: " << chosen << '\n';
+        }
+        out.flush();
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
     }
-    cout << "Total weight of MST: " << totalWeight << endl;
 
     return 0;
 }
@@ -139,14 +217,37 @@ int main() {
  *  - The edges are sorted by weight in ascending order.
  *  - A union-find data structure is used to detect cycles and merge subsets.
  *
- * Functions:
- *  1. `find`: Finds the root of a subset using path compression for efficiency.
- *  2. `unionSubsets`: Merges two subsets using union by rank.
+ * Functions (minimum_spanning_tree.h, except `densitySweepBenchmark`):
+ *  1. `DisjointSet` (disjoint_set.h): Union-find with iterative path halving and union by size.
+ *  2. `ConcurrentDisjointSet` (disjoint_set.h): Lock-free union-find used by the parallel mode.
  *  3. `compareEdges`: Compares two edges based on their weight for sorting.
+ *  4. `kruskalMST`: Sorts all edges and adds them in order, skipping cycle-forming edges.
+ *  5. `filterKruskalMST`: Filter-Kruskal; partitions edges around pivot weights like quick sort,
+ *     handles the light part first and discards heavy edges inside one subset before sorting them.
+ *  6. `parallelBoruvkaMST`: Parallel Boruvka; every component picks its cheapest outgoing edge
+ *     in parallel (atomic minimum on packed weight and edge id) and merges through `ConcurrentDisjointSet`.
+ *  7. `LinkCutTree`: Dynamic forest with link, cut and path-maximum queries in O(log V) amortized.
+ *  8. `IncrementalMST`: Keeps the minimum spanning forest of a stream of edges; a new edge that
+ *     closes a cycle replaces the heaviest edge on it if it is lighter (cycle property).
+ *  9. `semiExternalKruskalMST`: Kruskal over a binary edge file larger than memory. Batches are
+ *     sorted into runs on disk, each pruned to its own spanning forest, then merged by weight.
+ * 10. `IndexedHeap`: d-ary min-heap of vertices with a position index, so decrease-key is O(log V).
+ * 11. `heapPrimMST`: Prim's algorithm on an adjacency array with a 4-ary indexed heap.
+ * 12. `arrayPrimMST`: Prim's algorithm with a linear scan for the minimum, for dense graphs.
+ * 13. `autoMST`: Chooses Filter-Kruskal, heap-based Prim or array-based Prim from V and E.
+ * 14. `densitySweepBenchmark`: Times all algorithms across densities to show the crossover points.
  *
  * Input:
+ *  - The user chooses the algorithm (1 = Kruskal, 2 = Filter-Kruskal, 3 = Parallel Boruvka,
+ *    4 = Streaming, which prints the current MST weight after every edge,
+ *    5 = Semi-external, which reads a binary edge file instead of typed edges,
+ *    6 = Heap-based Prim, 7 = Array-based Prim, 8 = Automatic, which also prints the algorithm used,
+ *    9 = Density sweep benchmark, which only asks for the number of vertices).
  *  - The user inputs the number of vertices and edges.
  *  - The user then provides each edge in the format: source vertex, destination vertex, weight.
+ *  - With `--batch [file]` the same values are read without prompts from the file (or from
+ *    standard input); edges are parsed by the buffered reader in fast_io.h, which is what
+ *    makes multi-million-edge inputs practical.
  *
  * Output:
  *  - The edges included in the MST.
@@ -157,10 +258,19 @@ int main() {
  *     * Sorting edges: O(E * log(E))
  *     * Union-Find operations: O(E * log(V)) (amortized)
  *     Total: O(E * log(E) + E * log(V))
+ *     * Filter-Kruskal: O(E + V * log(V) * log(E / V)) expected on random weights, since only
+ *       edges that can still join two subsets get sorted.
+ *     * Parallel Boruvka: O(log V) rounds of O((E + V) / p) work each with p threads.
+ *     * Streaming: O(log V) amortized per inserted edge; the total weight is read in O(1).
+ *     * Semi-external: O(E * log(M)) to form runs of M edges, then a merge of at most
+ *       (E / M) * (V - 1) pruned edges; memory is O(V + M).
+ *     * Heap-based Prim: O(E * log(V)) with no dependence on the weights.
+ *     * Array-based Prim: O(V^2 + E), optimal for near-complete graphs.
  *  - Space Complexity: O(V) for union-find subsets.
  *
  * Example:
  *  - Input:
+ *     Enter your choice: 1
  *     Enter the number of vertices: 4
  *     Enter the number of edges: 5
  *     Enter the edges in the format (src dest weight):
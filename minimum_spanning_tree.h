@@ -0,0 +1,929 @@
+#ifndef MINIMUM_SPANNING_TREE_H
+#define MINIMUM_SPANNING_TREE_H
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <functional>
+#include <array>
+#include <climits>
+#include <queue>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "disjoint_set.h"
+
+/*
+ * Minimum spanning trees of undirected, weighted graphs.
+ * Contains:
+ *  - `Edge`, `compareEdges`: The edge list representation shared by every algorithm.
+ *  - `kruskalMST`, `filterKruskalMST`: Kruskal's algorithm on fully sorted or filtered edges.
+ *  - `parallelBoruvkaMST`: Boruvka rounds on all cores over `ConcurrentDisjointSet`.
+ *  - `LinkCutTree`, `IncrementalMST`: A minimum spanning forest kept current under edge insertions.
+ *  - `semiExternalKruskalMST`: Kruskal over a binary edge file larger than memory.
+ *  - `heapPrimMST`, `arrayPrimMST`: Prim's algorithm for medium and near-complete densities.
+ *  - `autoMST`: Chooses among them from V and E.
+ */
+namespace mst {
+
+/*
+ * Structure to represent an edge of the graph.
+ * Contains:
+ *  - `src`: Source vertex
+ *  - `dest`: Destination vertex
+ *  - `weight`: Weight of the edge
+ */
+struct Edge {
+    int src, dest, weight;
+};
+
+/*
+ * Function to compare two edges by weight.
+ * Used for sorting edges in ascending order.
+ */
+inline bool compareEdges(const Edge& e1, const Edge& e2) {
+    return e1.weight < e2.weight;
+}
+
+/*
+ * Function to add the edges of edges[low..high) to the MST in the given order,
+ * skipping edges that would form a cycle and stopping once the MST has V-1 edges.
+ */
+inline void addEdgesInOrder(const std::vector<Edge>& edges, int low, int high, DisjointSet& subsets,
+                            std::vector<Edge>& mst, int V) {
+    for (int i = low; i < high && (int)mst.size() < V - 1; i++) {
+        // If including this edge doesn't form a cycle
+        if (subsets.unite(edges[i].src, edges[i].dest)) {
+            mst.push_back(edges[i]);
+        }
+    }
+}
+
+/*
+ * Kruskal's algorithm.
+ * Parameters:
+ *  - edges: Edges of the graph (sorted in place)
+ *  - V: Number of vertices
+ * Returns:
+ *  - The edges of the MST (a spanning forest if the graph is disconnected).
+ */
+inline std::vector<Edge> kruskalMST(std::vector<Edge>& edges, int V) {
+    // Sort edges in ascending order by weight
+    std::sort(edges.begin(), edges.end(), compareEdges);
+
+    // Create subsets for union-find
+    DisjointSet subsets(V);
+
+    // Iterate through sorted edges and build MST
+    std::vector<Edge> mst;
+    addEdgesInOrder(edges, 0, edges.size(), subsets, mst, V);
+    return mst;
+}
+
+// Ranges with at most this many edges are sorted directly by Filter-Kruskal
+const int FILTER_KRUSKAL_THRESHOLD = 1024;
+
+/*
+ * Filter-Kruskal on edges[low..high).
+ * Logic:
+ *  - Split the range around a random pivot weight into light (< pivot), equal and
+ *    heavy (> pivot) edges, like one quick sort partition.
+ *  - Process the light edges recursively, then the equal ones (no sorting needed).
+ *  - Drop heavy edges whose endpoints are already connected, then process the rest.
+ *    Most heavy edges are dropped here without ever being sorted.
+ */
+inline void filterKruskal(std::vector<Edge>& edges, int low, int high, DisjointSet& subsets,
+                          std::vector<Edge>& mst, int V, std::mt19937& rng) {
+    if ((int)mst.size() >= V - 1 || low >= high) {
+        return;
+    }
+    if (high - low <= FILTER_KRUSKAL_THRESHOLD) {
+        std::sort(edges.begin() + low, edges.begin() + high, compareEdges);
+        addEdgesInOrder(edges, low, high, subsets, mst, V);
+        return;
+    }
+
+    int pivot = edges[low + rng() % (high - low)].weight;
+    auto first = edges.begin();
+    int lightEnd = std::partition(first + low, first + high, [pivot](const Edge& e) { return e.weight < pivot; }) - first;
+    int equalEnd = std::partition(first + lightEnd, first + high, [pivot](const Edge& e) { return e.weight == pivot; }) - first;
+
+    filterKruskal(edges, low, lightEnd, subsets, mst, V, rng);
+    addEdgesInOrder(edges, lightEnd, equalEnd, subsets, mst, V);
+    if ((int)mst.size() >= V - 1) {
+        return;
+    }
+
+    // Filter: keep only heavy edges that still join two different subsets
+    int heavyEnd = std::partition(first + equalEnd, first + high, [&subsets](const Edge& e) {
+        return !subsets.connected(e.src, e.dest);
+    }) - first;
+    filterKruskal(edges, equalEnd, heavyEnd, subsets, mst, V, rng);
+}
+
+// Function to compute the MST with Filter-Kruskal (reorders `edges`)
+inline std::vector<Edge> filterKruskalMST(std::vector<Edge>& edges, int V) {
+    DisjointSet subsets(V);
+    std::vector<Edge> mst;
+    std::mt19937 rng(12345);
+    filterKruskal(edges, 0, edges.size(), subsets, mst, V, rng);
+    return mst;
+}
+
+// Function to run body(begin, end, thread) on `threads` contiguous chunks of [0, n) in parallel
+inline void parallelFor(size_t n, int threads, const std::function<void(size_t, size_t, int)>& body) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        size_t begin = n * t / threads, end = n * (t + 1) / threads;
+        workers.emplace_back(body, begin, end, t);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Function to pack (weight, edge id) into one word whose unsigned order is weight order, then id order
+inline uint64_t packEdge(int weight, uint32_t id) {
+    return ((uint64_t)((uint32_t)weight ^ 0x80000000u) << 32) | id;
+}
+
+// Function to lower `slot` to `value` if that is smaller
+inline void atomicMin(std::atomic<uint64_t>& slot, uint64_t value) {
+    uint64_t current = slot.load(std::memory_order_relaxed);
+    while (value < current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+/*
+ * Parallel Boruvka's algorithm.
+ * Parameters:
+ *  - edges: Edges of the graph (not modified)
+ *  - V: Number of vertices
+ *  - threads: Number of threads
+ * Returns:
+ *  - The edges of the MST (a spanning forest if the graph is disconnected).
+ * Logic (each round, every step in parallel):
+ *  1. Every edge between two components offers itself as the minimum outgoing edge of both,
+ *     through an atomic minimum on a packed (weight, edge id) word per component. The edge id
+ *     breaks ties, so all threads agree on one total order and the chosen edges have no cycle.
+ *  2. Every component merges along its chosen edge; the edge joins the MST if `unite` succeeds
+ *     (two components that chose the same edge add it only once).
+ *  3. Edges inside one component are removed from the active edge list.
+ * The number of components at least halves every round, so there are O(log V) rounds.
+ */
+inline std::vector<Edge> parallelBoruvkaMST(const std::vector<Edge>& edges, int V, int threads) {
+    const uint64_t NONE = UINT64_MAX;
+    if (threads < 1) threads = 1;
+
+    ConcurrentDisjointSet components(V);
+    std::vector<std::atomic<uint64_t>> cheapest(V);
+    for (int v = 0; v < V; v++) {
+        cheapest[v].store(NONE, std::memory_order_relaxed);
+    }
+
+    std::vector<uint32_t> active(edges.size());
+    for (size_t i = 0; i < edges.size(); i++) {
+        active[i] = i;
+    }
+
+    std::vector<Edge> mst;
+    std::vector<std::vector<uint32_t>> chosen(threads);
+    std::vector<size_t> keptCount(threads);
+    while (!active.empty()) {
+        // Step 1: Minimum outgoing edge of every component
+        parallelFor(active.size(), threads, [&](size_t begin, size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                const Edge& e = edges[active[i]];
+                int cu = components.find(e.src), cv = components.find(e.dest);
+                if (cu != cv) {
+                    uint64_t packed = packEdge(e.weight, active[i]);
+                    atomicMin(cheapest[cu], packed);
+                    atomicMin(cheapest[cv], packed);
+                }
+            }
+        });
+
+        // Step 2: Merge every component along its chosen edge
+        parallelFor(V, threads, [&](size_t begin, size_t end, int t) {
+            for (size_t v = begin; v < end; v++) {
+                uint64_t packed = cheapest[v].load(std::memory_order_relaxed);
+                if (packed == NONE) continue;
+                cheapest[v].store(NONE, std::memory_order_relaxed);
+                uint32_t id = (uint32_t)packed;
+                if (components.unite(edges[id].src, edges[id].dest)) {
+                    chosen[t].push_back(id);
+                }
+            }
+        });
+
+        size_t added = 0;
+        for (std::vector<uint32_t>& list : chosen) {
+            for (uint32_t id : list) mst.push_back(edges[id]);
+            added += list.size();
+            list.clear();
+        }
+        if (added == 0) break;
+
+        // Step 3: Compact the active edge list (count per chunk, then copy to prefix offsets)
+        parallelFor(active.size(), threads, [&](size_t begin, size_t end, int t) {
+            size_t kept = begin;
+            for (size_t i = begin; i < end; i++) {
+                const Edge& e = edges[active[i]];
+                if (components.find(e.src) != components.find(e.dest)) {
+                    active[kept++] = active[i];
+                }
+            }
+            keptCount[t] = kept - begin;
+        });
+        std::vector<uint32_t> next;
+        next.reserve(active.size());
+        for (int t = 0; t < threads; t++) {
+            size_t begin = active.size() * t / threads;
+            next.insert(next.end(), active.begin() + begin, active.begin() + begin + keptCount[t]);
+        }
+        active.swap(next);
+    }
+    return mst;
+}
+
+/*
+ * Link-cut tree over a forest whose nodes carry weights.
+ * Contains:
+ *  - `child`, `parent`: Splay-tree links; a splay root's `parent` is its path-parent pointer.
+ *  - `reversed`: Lazy flag for reversing a splay subtree (used to re-root a tree).
+ *  - `weight`: Weight of each node.
+ *  - `maxNode`: Node of maximum weight in each splay subtree.
+ * Every operation costs O(log n) amortized.
+ */
+class LinkCutTree {
+private:
+    std::vector<std::array<int, 2>> child;
+    std::vector<int> parent;
+    std::vector<bool> reversed;
+    std::vector<int> weight;
+    std::vector<int> maxNode;
+
+    bool isSplayRoot(int x) const {
+        int p = parent[x];
+        return p == -1 || (child[p][0] != x && child[p][1] != x);
+    }
+
+    void pushDown(int x) {
+        if (reversed[x]) {
+            std::swap(child[x][0], child[x][1]);
+            for (int c : child[x]) {
+                if (c != -1) reversed[c] = !reversed[c];
+            }
+            reversed[x] = false;
+        }
+    }
+
+    void pullUp(int x) {
+        maxNode[x] = x;
+        for (int c : child[x]) {
+            if (c != -1 && weight[maxNode[c]] > weight[maxNode[x]]) {
+                maxNode[x] = maxNode[c];
+            }
+        }
+    }
+
+    void rotate(int x) {
+        int p = parent[x], g = parent[p];
+        int side = child[p][1] == x;
+        if (!isSplayRoot(p)) {
+            child[g][child[g][1] == p] = x;
+        }
+        parent[x] = g;
+        child[p][side] = child[x][!side];
+        if (child[x][!side] != -1) parent[child[x][!side]] = p;
+        child[x][!side] = p;
+        parent[p] = x;
+        pullUp(p);
+        pullUp(x);
+    }
+
+    void splay(int x) {
+        // Push lazy flags down from the splay root first
+        std::vector<int>& path = splayPath;
+        path.clear();
+        for (int y = x;; y = parent[y]) {
+            path.push_back(y);
+            if (isSplayRoot(y)) break;
+        }
+        for (int i = path.size() - 1; i >= 0; i--) {
+            pushDown(path[i]);
+        }
+
+        while (!isSplayRoot(x)) {
+            int p = parent[x];
+            if (!isSplayRoot(p)) {
+                int g = parent[p];
+                rotate((child[g][1] == p) == (child[p][1] == x) ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    // Make the root-to-x path preferred; afterwards x is the root of its splay tree
+    void access(int x) {
+        int last = -1;
+        for (int y = x; y != -1; y = parent[y]) {
+            splay(y);
+            child[y][1] = last;
+            pullUp(y);
+            last = y;
+        }
+        splay(x);
+    }
+
+    void makeRoot(int x) {
+        access(x);
+        reversed[x] = !reversed[x];
+    }
+
+    std::vector<int> splayPath; // Scratch space for `splay`
+
+public:
+    LinkCutTree(int n) : child(n, {-1, -1}), parent(n, -1), reversed(n, false), weight(n, INT_MIN), maxNode(n) {
+        for (int i = 0; i < n; i++) {
+            maxNode[i] = i;
+        }
+    }
+
+    // Function to set the weight of an isolated node
+    void setWeight(int x, int w) {
+        weight[x] = w;
+        maxNode[x] = x;
+    }
+
+    int getWeight(int x) const {
+        return weight[x];
+    }
+
+    // Function to add the edge x-y; x and y must be in different trees
+    void link(int x, int y) {
+        makeRoot(x);
+        parent[x] = y;
+    }
+
+    // Function to remove the edge x-y, which must exist
+    void cut(int x, int y) {
+        makeRoot(x);
+        access(y);
+        // Now x is y's left child with nothing between them
+        child[y][0] = -1;
+        parent[x] = -1;
+        pullUp(y);
+    }
+
+    // Function to find the node of maximum weight on the path x..y (same tree)
+    int pathMax(int x, int y) {
+        makeRoot(x);
+        access(y);
+        return maxNode[y];
+    }
+};
+
+/*
+ * Incremental minimum spanning forest for a stream of edges.
+ * Contains:
+ *  - `tree`: Link-cut tree over V vertex nodes plus up to V-1 edge nodes (weight = edge weight),
+ *    so the heaviest edge on a tree path is a path-maximum query.
+ *  - `components`: Connectivity; components only ever merge, because a replaced edge is always
+ *    swapped for a new edge between the same two parts.
+ *  - `totalWeight`: Weight of the current forest, kept up to date on every change.
+ * Logic (cycle property):
+ *  - An edge between two components joins the forest.
+ *  - Otherwise it closes a cycle with the forest path between its endpoints; if the heaviest
+ *    edge on that path is heavier than the new edge, that edge is cut and the new one linked.
+ */
+class IncrementalMST {
+private:
+    int V;
+    LinkCutTree tree;
+    DisjointSet components;
+    std::vector<Edge> forestEdges; // Edge held by each edge node (index - V)
+    std::vector<int> freeSlots;    // Unused edge nodes
+    long long totalWeight;
+    int edgeCount;
+
+public:
+    IncrementalMST(int _V) : V(_V), tree(2 * _V), components(_V), forestEdges(_V), totalWeight(0), edgeCount(0) {
+        for (int slot = V - 1; slot >= 0; slot--) {
+            freeSlots.push_back(slot);
+        }
+    }
+
+    // Function to insert one edge; returns true if the forest changed
+    bool insert(const Edge& edge) {
+        int u = edge.src, v = edge.dest;
+        if (u == v) {
+            return false;
+        }
+
+        if (!components.connected(u, v)) {
+            components.unite(u, v);
+        } else {
+            int heaviest = tree.pathMax(u, v);
+            if (tree.getWeight(heaviest) <= edge.weight) {
+                return false; // The new edge is the heaviest on its cycle
+            }
+            const Edge& old = forestEdges[heaviest - V];
+            tree.cut(heaviest, old.src);
+            tree.cut(heaviest, old.dest);
+            totalWeight -= old.weight;
+            edgeCount--;
+            freeSlots.push_back(heaviest - V);
+        }
+
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        int node = V + slot;
+        forestEdges[slot] = edge;
+        tree.setWeight(node, edge.weight);
+        tree.link(u, node);
+        tree.link(node, v);
+        totalWeight += edge.weight;
+        edgeCount++;
+        return true;
+    }
+
+    // Function to insert a batch of edges (lightest first, which avoids needless replacements)
+    void insertBatch(std::vector<Edge> batch) {
+        std::sort(batch.begin(), batch.end(), compareEdges);
+        for (const Edge& edge : batch) {
+            insert(edge);
+        }
+    }
+
+    // Function to get the current total weight in O(1)
+    long long weight() const {
+        return totalWeight;
+    }
+
+    // Function to list the edges of the current forest
+    std::vector<Edge> edges() const {
+        std::vector<bool> isFree(V, false);
+        for (int slot : freeSlots) {
+            isFree[slot] = true;
+        }
+        std::vector<Edge> result;
+        for (int slot = 0; slot < V; slot++) {
+            if (!isFree[slot]) result.push_back(forestEdges[slot]);
+        }
+        return result;
+    }
+};
+
+/*
+ * Semi-external Kruskal for edge files larger than memory.
+ * The edge file holds binary `Edge` records (three native-endian ints: src, dest, weight).
+ * Only O(V) union-find state and the I/O buffers are resident: edges are sorted into
+ * weight-ordered runs on disk and consumed by Kruskal's loop in one merged pass.
+ */
+
+// Edges held by each run reader's buffer
+const size_t EDGE_RUN_BUFFER = 1 << 16;
+
+// Function to open a file, throwing if that fails
+inline FILE* openEdgeFile(const std::string& path, const char* mode) {
+    FILE* file = fopen(path.c_str(), mode);
+    if (file == nullptr) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    return file;
+}
+
+// Deleter that closes the file of an `EdgeFileHandle`
+struct EdgeFileCloser {
+    void operator()(FILE* file) const { fclose(file); }
+};
+
+// Owning file handle, so the edge file is closed when run formation throws
+typedef std::unique_ptr<FILE, EdgeFileCloser> EdgeFileHandle;
+
+// Buffered sequential reader of a run of edges
+class EdgeRunReader {
+private:
+    std::string path;
+    FILE* file;
+    std::vector<Edge> buffer;
+    size_t pos, len;
+
+public:
+    EdgeRunReader(const std::string& _path)
+        : path(_path), file(openEdgeFile(_path, "rb")), buffer(EDGE_RUN_BUFFER), pos(0), len(0) {}
+
+    ~EdgeRunReader() {
+        fclose(file);
+    }
+
+    // Function to fetch the next edge; returns false at the end of the run, throws runtime_error on a read error
+    bool next(Edge& edge) {
+        if (pos == len) {
+            len = fread(buffer.data(), sizeof(Edge), buffer.size(), file);
+            pos = 0;
+            if (ferror(file)) {
+                throw std::runtime_error("cannot read " + path);
+            }
+            if (len == 0) return false;
+        }
+        edge = buffer[pos++];
+        return true;
+    }
+};
+
+/*
+ * Function to prune a weight-sorted batch of edges down to its own minimum spanning forest.
+ * An edge whose endpoints are already connected by lighter edges of the same batch is the
+ * heaviest edge on a cycle, so it cannot be in the MST of the whole graph (cycle property).
+ * Every run therefore holds at most V-1 edges, however many edges were read into it.
+ */
+inline void pruneSortedBatch(std::vector<Edge>& batch, int V) {
+    DisjointSet subsets(V);
+    size_t kept = 0;
+    for (const Edge& edge : batch) {
+        if (subsets.unite(edge.src, edge.dest)) {
+            batch[kept++] = edge;
+        }
+    }
+    batch.resize(kept);
+}
+
+// Function to write a batch of edges as a run file
+inline void writeEdgeRun(const std::string& path, const std::vector<Edge>& edges) {
+    FILE* out = openEdgeFile(path, "wb");
+    bool ok = fwrite(edges.data(), sizeof(Edge), edges.size(), out) == edges.size();
+    ok = fclose(out) == 0 && ok;
+    if (!ok) {
+        throw std::runtime_error("cannot write " + path);
+    }
+}
+
+/*
+ * Function to merge weight-sorted runs and pass their edges to `consume` in weight order.
+ * Stops early when `consume` returns false.
+ */
+inline void mergeEdgeRuns(const std::vector<std::string>& runs, const std::function<bool(const Edge&)>& consume) {
+    std::vector<std::unique_ptr<EdgeRunReader>> readers;
+    std::vector<Edge> heads(runs.size());
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> queue; // (weight, run)
+    for (size_t r = 0; r < runs.size(); r++) {
+        readers.push_back(std::unique_ptr<EdgeRunReader>(new EdgeRunReader(runs[r])));
+        if (readers[r]->next(heads[r])) {
+            queue.push({heads[r].weight, (int)r});
+        }
+    }
+
+    while (!queue.empty()) {
+        int r = queue.top().second;
+        queue.pop();
+        if (!consume(heads[r])) {
+            return;
+        }
+        if (readers[r]->next(heads[r])) {
+            queue.push({heads[r].weight, r});
+        }
+    }
+}
+
+/*
+ * Semi-external Kruskal's algorithm.
+ * Parameters:
+ *  - edgePath: Binary edge file
+ *  - V: Number of vertices
+ *  - memoryBytes: Memory budget for edge batches and run buffers
+ *  - tempDir: Directory for the temporary run files
+ *  - mst: Receives the MST edges
+ * Throws:
+ *  - std::runtime_error if a file cannot be read or written; the run files (including those
+ *    of an unfinished merge pass) are removed first.
+ * Logic:
+ *  1. Read the file in batches that fit the budget, sort each batch by weight, prune it to
+ *     its own spanning forest and write it as a run.
+ *  2. If there are more runs than the budget can buffer at once, merge groups of runs
+ *     (pruning again, so a merged run also holds at most V-1 edges).
+ *  3. Merge the remaining runs in weight order into Kruskal's loop, stopping at V-1 edges.
+ */
+inline void semiExternalKruskalMST(const std::string& edgePath, int V, size_t memoryBytes, const std::string& tempDir,
+                                   std::vector<Edge>& mst) {
+    size_t budget = std::max<size_t>(memoryBytes / sizeof(Edge), 4 * EDGE_RUN_BUFFER);
+    std::string prefix = tempDir + "/mst_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::vector<std::string> runs;
+    std::vector<std::string> created; // Every run file, removed when the function returns or throws
+    int runCounter = 0;
+    mst.clear();
+
+    try {
+        // Step 1: Sorted, pruned runs
+        {
+            EdgeFileHandle in(openEdgeFile(edgePath, "rb"));
+            std::vector<Edge> batch(budget);
+            while (true) {
+                size_t count = fread(batch.data(), sizeof(Edge), budget, in.get());
+                if (ferror(in.get())) {
+                    throw std::runtime_error("cannot read " + edgePath);
+                }
+                if (count == 0) break;
+                batch.resize(count);
+                std::sort(batch.begin(), batch.end(), compareEdges);
+                pruneSortedBatch(batch, V);
+
+                created.push_back(prefix + "_" + std::to_string(runCounter++) + ".run");
+                runs.push_back(created.back());
+                writeEdgeRun(runs.back(), batch);
+                batch.resize(budget);
+            }
+        }
+
+        // Step 2: Merge passes while the runs cannot all be buffered at once
+        size_t maxFanIn = std::max<size_t>(2, budget / EDGE_RUN_BUFFER - 1);
+        while (runs.size() > maxFanIn) {
+            std::vector<std::string> merged;
+            for (size_t first = 0; first < runs.size(); first += maxFanIn) {
+                std::vector<std::string> group(runs.begin() + first, runs.begin() + std::min(runs.size(), first + maxFanIn));
+                std::vector<Edge> forest;
+                DisjointSet subsets(V);
+                mergeEdgeRuns(group, [&](const Edge& edge) {
+                    if (subsets.unite(edge.src, edge.dest)) forest.push_back(edge);
+                    return (int)forest.size() < V - 1;
+                });
+                created.push_back(prefix + "_" + std::to_string(runCounter++) + ".run");
+                merged.push_back(created.back());
+                writeEdgeRun(merged.back(), forest);
+                for (const std::string& run : group) remove(run.c_str());
+            }
+            runs.swap(merged);
+        }
+
+        // Step 3: Kruskal over the merged runs with only the union-find resident
+        DisjointSet subsets(V);
+        mergeEdgeRuns(runs, [&](const Edge& edge) {
+            if (subsets.unite(edge.src, edge.dest)) mst.push_back(edge);
+            return (int)mst.size() < V - 1;
+        });
+    } catch (...) {
+        for (const std::string& run : created) remove(run.c_str());
+        throw;
+    }
+
+    for (const std::string& run : created) remove(run.c_str());
+}
+
+/*
+ * Adjacency of an undirected graph in compressed sparse row form.
+ * Contains:
+ *  - `start`: Neighbours of v are entries start[v] .. start[v+1]-1.
+ *  - `neighbor`, `weight`: Neighbour vertex and edge weight of every entry.
+ */
+struct AdjacencyList {
+    std::vector<int> start;
+    std::vector<int> neighbor;
+    std::vector<int> weight;
+};
+
+// Function to build the adjacency (each edge in both directions, self-loops dropped)
+inline AdjacencyList buildAdjacency(const std::vector<Edge>& edges, int V) {
+    AdjacencyList adj;
+    adj.start.assign(V + 1, 0);
+    for (const Edge& e : edges) {
+        if (e.src == e.dest) continue;
+        adj.start[e.src + 1]++;
+        adj.start[e.dest + 1]++;
+    }
+    for (int v = 0; v < V; v++) {
+        adj.start[v + 1] += adj.start[v];
+    }
+    adj.neighbor.resize(adj.start[V]);
+    adj.weight.resize(adj.start[V]);
+    std::vector<int> fill(adj.start.begin(), adj.start.end() - 1);
+    for (const Edge& e : edges) {
+        if (e.src == e.dest) continue;
+        adj.neighbor[fill[e.src]] = e.dest;
+        adj.weight[fill[e.src]++] = e.weight;
+        adj.neighbor[fill[e.dest]] = e.src;
+        adj.weight[fill[e.dest]++] = e.weight;
+    }
+    return adj;
+}
+
+/*
+ * Indexed d-ary min-heap of vertices keyed by weight.
+ * Contains:
+ *  - `heap`: Vertices in heap order.
+ *  - `position`: Index of each vertex in `heap`, or -1 if it is not in the heap.
+ *  - `key`: Current key of each vertex.
+ * `position` makes decrease-key O(log_D V); D = 4 keeps the tree shallow and the
+ * children of a node in one cache line.
+ */
+template <int D>
+class IndexedHeap {
+private:
+    std::vector<int> heap;
+    std::vector<int> position;
+    std::vector<int> key;
+
+    void place(int index, int v) {
+        heap[index] = v;
+        position[v] = index;
+    }
+
+    void siftUp(int index) {
+        int v = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / D;
+            if (key[heap[parent]] <= key[v]) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, v);
+    }
+
+    void siftDown(int index) {
+        int v = heap[index];
+        int size = heap.size();
+        while (true) {
+            int first = index * D + 1;
+            if (first >= size) break;
+            int best = first;
+            for (int c = first + 1; c < std::min(first + D, size); c++) {
+                if (key[heap[c]] < key[heap[best]]) best = c;
+            }
+            if (key[heap[best]] >= key[v]) break;
+            place(index, heap[best]);
+            index = best;
+        }
+        place(index, v);
+    }
+
+public:
+    IndexedHeap(int n) : position(n, -1), key(n) {}
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    bool contains(int v) const {
+        return position[v] != -1;
+    }
+
+    // Function to get the key of v (still valid after v has been popped)
+    int keyOf(int v) const {
+        return key[v];
+    }
+
+    // Function to insert v with key k
+    void push(int v, int k) {
+        key[v] = k;
+        heap.push_back(v);
+        siftUp(heap.size() - 1);
+    }
+
+    // Function to lower the key of v (which is in the heap) to k
+    void decreaseKey(int v, int k) {
+        key[v] = k;
+        siftUp(position[v]);
+    }
+
+    // Function to remove and return the vertex with the smallest key
+    int popMin() {
+        int top = heap[0];
+        position[top] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, last);
+            siftDown(0);
+        }
+        return top;
+    }
+};
+
+/*
+ * Prim's algorithm with an indexed 4-ary heap.
+ * Returns:
+ *  - The MST edges (a spanning forest if the graph is disconnected).
+ * Complexity: O(E * log(V)), with cheap decrease-key operations.
+ */
+inline std::vector<Edge> heapPrimMST(const std::vector<Edge>& edges, int V) {
+    AdjacencyList adj = buildAdjacency(edges, V);
+    IndexedHeap<4> heap(V);
+    std::vector<bool> inTree(V, false);
+    std::vector<int> via(V, -1); // Tree vertex that offers the current key
+    std::vector<Edge> mst;
+
+    for (int root = 0; root < V; root++) {
+        if (inTree[root]) continue;
+        heap.push(root, INT_MIN);
+        while (!heap.empty()) {
+            int u = heap.popMin();
+            inTree[u] = true;
+            if (via[u] != -1) {
+                mst.push_back({via[u], u, heap.keyOf(u)});
+            }
+            for (int i = adj.start[u]; i < adj.start[u + 1]; i++) {
+                int v = adj.neighbor[i], w = adj.weight[i];
+                if (inTree[v]) continue;
+                if (!heap.contains(v)) {
+                    heap.push(v, w);
+                    via[v] = u;
+                } else if (w < heap.keyOf(v)) {
+                    heap.decreaseKey(v, w);
+                    via[v] = u;
+                }
+            }
+        }
+    }
+    return mst;
+}
+
+/*
+ * Array-based Prim's algorithm for dense graphs.
+ * Every step scans the vertices not yet in the tree for the smallest key instead of using
+ * a heap, so there is no heap overhead at all. Complexity: O(V^2 + E), which is optimal
+ * when E is close to V^2.
+ */
+inline std::vector<Edge> arrayPrimMST(const std::vector<Edge>& edges, int V) {
+    AdjacencyList adj = buildAdjacency(edges, V);
+    std::vector<long long> key(V, LLONG_MAX); // LLONG_MAX = not reached yet
+    std::vector<int> via(V, -1);
+    std::vector<bool> inTree(V, false);
+    std::vector<int> remaining(V); // Vertices not in the tree; the chosen one is swapped out
+    for (int v = 0; v < V; v++) {
+        remaining[v] = v;
+    }
+    std::vector<Edge> mst;
+
+    while (!remaining.empty()) {
+        // An unreached minimum means a new component: it starts a new tree
+        int best = 0;
+        for (int i = 1; i < (int)remaining.size(); i++) {
+            if (key[remaining[i]] < key[remaining[best]]) best = i;
+        }
+        int u = remaining[best];
+        remaining[best] = remaining.back();
+        remaining.pop_back();
+
+        inTree[u] = true;
+        if (via[u] != -1) {
+            mst.push_back({via[u], u, (int)key[u]});
+        }
+        for (int i = adj.start[u]; i < adj.start[u + 1]; i++) {
+            int v = adj.neighbor[i];
+            if (!inTree[v] && adj.weight[i] < key[v]) {
+                key[v] = adj.weight[i];
+                via[v] = u;
+            }
+        }
+    }
+    return mst;
+}
+
+// Graphs at least this dense (fraction of all V(V-1)/2 vertex pairs) use array-based Prim
+const double ARRAY_PRIM_DENSITY = 0.5;
+
+// Graphs with at least this many edges per vertex (but below ARRAY_PRIM_DENSITY) use heap-based Prim
+const double HEAP_PRIM_EDGES_PER_VERTEX = 16;
+
+// Function to compute the fraction of vertex pairs that are joined by an edge
+inline double graphDensity(long long E, int V) {
+    return V > 1 ? 2.0 * E / ((double)V * (V - 1)) : 0;
+}
+
+/*
+ * MST facade: chooses the algorithm from V and E.
+ * Parameters:
+ *  - edges: Edges of the graph (may be reordered)
+ *  - V: Number of vertices
+ *  - mst: Receives the MST edges
+ * Returns:
+ *  - The name of the algorithm that was used.
+ * Logic (thresholds from the density sweep benchmark):
+ *  - Near-complete graphs: array-based Prim, O(V^2) with no sorting and no heap.
+ *  - From about 16 edges per vertex: heap-based Prim. Filter-Kruskal is faster when most heavy
+ *    edges can be filtered, but its cost depends on the weights and degrades to a full sort
+ *    when they cannot; Prim's O(E log V) does not, and it stays within a small factor of
+ *    Filter-Kruskal in the best case.
+ *  - Sparse graphs: Filter-Kruskal, which sorts only the edges that can still matter.
+ */
+inline const char* autoMST(std::vector<Edge>& edges, int V, std::vector<Edge>& mst) {
+    if (graphDensity(edges.size(), V) >= ARRAY_PRIM_DENSITY) {
+        mst = arrayPrimMST(edges, V);
+        return "Array-based Prim";
+    }
+    if (edges.size() >= HEAP_PRIM_EDGES_PER_VERTEX * V) {
+        mst = heapPrimMST(edges, V);
+        return "Heap-based Prim";
+    }
+    mst = filterKruskalMST(edges, V);
+    return "Filter-Kruskal";
+}
+
+} // namespace mst
+
+#endif
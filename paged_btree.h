@@ -0,0 +1,755 @@
+#ifndef PAGED_BTREE_H
+#define PAGED_BTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Disk-resident B+ Tree mapping int keys to int values.
+ * Contains:
+ *  - `PageFile`: A file of fixed-size pages read and written with pread/pwrite.
+ *  - `BufferPool`: A fixed number of in-memory page frames with pin/unpin, CLOCK replacement
+ *    and write-back of dirty pages on eviction.
+ *  - `PagedBTree`: The B+ Tree itself; nodes are pages and children are page IDs.
+ * File layout:
+ *  - Page 0 holds two metadata slots (at offsets 0 and 512, one disk sector each). Each slot
+ *    stores the page size, root page, page count, key count, the first free-list page, a
+ *    sequence number and a checksum.
+ *  - Pages 1 and up are tree nodes or free-list pages. A free-list page holds the next
+ *    free-list page, a count and that many IDs of free pages. Values are stored in host byte order.
+ * Pages are copy-on-write (shadow paging): a page reachable from the last checkpointed root is
+ * never written. The first update of such a page after a checkpoint copies it to a free page
+ * and repoints its parent, which is copied the same way, up to a new root. `checkpoint` writes
+ * back and syncs the new pages, then writes the next sequence number and the new root into the
+ * other metadata slot and syncs again; only then are the replaced pages reused. Opening picks
+ * the valid slot with the highest sequence number, so after a crash at any point the tree of
+ * the last completed checkpoint is intact, and a torn metadata write is detected by its checksum.
+ * Updates made after the last checkpoint are lost in a crash; they are not protected by a log.
+ * Each checkpoint also writes the free pages into new free-list pages referenced from its
+ * metadata slot. Reopening reads only the metadata; free-list pages are read when a page is
+ * allocated and nodes are loaded on demand by the buffer pool.
+ */
+namespace btree {
+
+typedef uint32_t PageId;
+
+const PageId NO_PAGE = 0; // Page 0 is the metadata page, so it is never a node
+const uint32_t METADATA_SLOT_BYTES = 512;
+const uint32_t MIN_PAGE_SIZE = 4096;
+const uint32_t MAX_PAGE_SIZE = 65536;
+
+// A file of fixed-size pages
+class PageFile {
+private:
+    int fd;
+    std::string path;
+
+    void readAt(uint64_t offset, char* buffer, size_t bytes) {
+        while (bytes > 0) {
+            ssize_t got = pread(fd, buffer, bytes, offset);
+            if (got < 0) {
+                throw std::runtime_error("cannot read " + path);
+            }
+            if (got == 0) {
+                memset(buffer, 0, bytes); // Past the end of the file: never written yet
+                return;
+            }
+            buffer += got;
+            offset += got;
+            bytes -= got;
+        }
+    }
+
+    void writeAt(uint64_t offset, const char* buffer, size_t bytes) {
+        while (bytes > 0) {
+            ssize_t put = pwrite(fd, buffer, bytes, offset);
+            if (put <= 0) {
+                throw std::runtime_error("cannot write " + path);
+            }
+            buffer += put;
+            offset += put;
+            bytes -= put;
+        }
+    }
+
+public:
+    uint32_t pageSize;
+
+    // Constructor: opens the file, creating it if it does not exist
+    explicit PageFile(const std::string& _path) : path(_path), pageSize(0) {
+        fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+    }
+
+    ~PageFile() {
+        close(fd);
+    }
+
+    PageFile(const PageFile&) = delete;
+    PageFile& operator=(const PageFile&) = delete;
+
+    void readPage(PageId page, char* buffer) {
+        readAt((uint64_t)page * pageSize, buffer, pageSize);
+    }
+
+    void writePage(PageId page, const char* buffer) {
+        writeAt((uint64_t)page * pageSize, buffer, pageSize);
+    }
+
+    void readMetadataSlot(int slot, char* buffer) {
+        readAt((uint64_t)slot * METADATA_SLOT_BYTES, buffer, METADATA_SLOT_BYTES);
+    }
+
+    void writeMetadataSlot(int slot, const char* buffer) {
+        writeAt((uint64_t)slot * METADATA_SLOT_BYTES, buffer, METADATA_SLOT_BYTES);
+    }
+
+    // Function to get the file size in bytes
+    uint64_t size() {
+        off_t end = lseek(fd, 0, SEEK_END);
+        if (end < 0) {
+            throw std::runtime_error("cannot read " + path);
+        }
+        return (uint64_t)end;
+    }
+
+    // Function to make all completed writes durable
+    void sync() {
+        if (fdatasync(fd) != 0) {
+            throw std::runtime_error("cannot sync " + path);
+        }
+    }
+};
+
+/*
+ * Buffer pool of page frames.
+ * Contains:
+ *  - `frames`: Per frame the cached page, its pin count, dirty flag and CLOCK reference bit.
+ *  - `table`: Page ID to frame index for the pages currently cached.
+ * A pinned page stays in its frame until every pin is released with `unpin`. When a page that
+ * is not cached is pinned, the CLOCK hand sweeps the frames, clearing reference bits, and
+ * evicts the first unpinned frame whose bit is already clear, writing it back if it is dirty.
+ * This approximates LRU without reordering a list on every access.
+ */
+class BufferPool {
+private:
+    struct Frame {
+        PageId page;
+        int pinCount;
+        bool dirty;
+        bool referenced;
+    };
+
+    PageFile& file;
+    std::vector<char> memory;
+    std::vector<Frame> frames;
+    std::unordered_map<PageId, size_t> table;
+    size_t hand;
+
+    // Function to find a frame to reuse, writing back its page if it is dirty
+    size_t evict() {
+        for (size_t step = 0; step < 2 * frames.size(); step++) {
+            size_t f = hand;
+            hand = (hand + 1) % frames.size();
+            Frame& frame = frames[f];
+            if (frame.pinCount > 0) {
+                continue;
+            }
+            if (frame.referenced) {
+                frame.referenced = false; // Second chance
+                continue;
+            }
+            if (frame.page != NO_PAGE) {
+                if (frame.dirty) {
+                    file.writePage(frame.page, data(f));
+                    writes++;
+                }
+                table.erase(frame.page);
+            }
+            return f;
+        }
+        throw std::runtime_error("buffer pool: every frame is pinned");
+    }
+
+    char* data(size_t f) {
+        return &memory[f * file.pageSize];
+    }
+
+    char* pinFrame(PageId page, bool fresh) {
+        std::unordered_map<PageId, size_t>::iterator it = table.find(page);
+        if (it != table.end()) {
+            Frame& frame = frames[it->second];
+            frame.pinCount++;
+            frame.referenced = true;
+            hits++;
+            if (fresh) { // A reused page may still be cached with its old contents
+                memset(data(it->second), 0, file.pageSize);
+                frame.dirty = true;
+            }
+            return data(it->second);
+        }
+
+        size_t f = evict();
+        if (fresh) {
+            memset(data(f), 0, file.pageSize);
+        } else {
+            file.readPage(page, data(f));
+            reads++;
+        }
+        frames[f] = Frame{page, 1, fresh, true};
+        table[page] = f;
+        return data(f);
+    }
+
+public:
+    unsigned long long hits = 0, reads = 0, writes = 0;
+
+    BufferPool(PageFile& _file, size_t frameCount)
+        : file(_file), memory(frameCount * _file.pageSize), frames(frameCount, Frame{NO_PAGE, 0, false, false}),
+          hand(0) {}
+
+    // Function to pin a page, reading it from the file if it is not cached
+    char* pin(PageId page) {
+        return pinFrame(page, false);
+    }
+
+    // Function to pin a newly allocated (or reused) page; it starts zeroed and dirty
+    char* pinNew(PageId page) {
+        return pinFrame(page, true);
+    }
+
+    // Function to release one pin; `dirty` records that the caller modified the page
+    void unpin(PageId page, bool dirty) {
+        Frame& frame = frames[table.at(page)];
+        frame.pinCount--;
+        frame.dirty = frame.dirty || dirty;
+    }
+
+    // Function to write every dirty page back to the file
+    void flushAll() {
+        for (size_t f = 0; f < frames.size(); f++) {
+            if (frames[f].page != NO_PAGE && frames[f].dirty) {
+                file.writePage(frames[f].page, data(f));
+                frames[f].dirty = false;
+                writes++;
+            }
+        }
+    }
+};
+
+/*
+ * A B+ Tree stored in a PageFile.
+ * Node page layout: a 16-byte header {leaf, n, unused, unused}, then
+ *  - leaf: keys[leafCapacity] followed by values[leafCapacity];
+ *  - internal: keys[innerCapacity] followed by child page IDs[innerCapacity + 1].
+ * Keys in internal nodes separate children as in `BPlusTree`: children[i] holds keys below
+ * keys[i] and children[i + 1] the keys from keys[i] on. Full nodes are split on the way down,
+ * so at most three pages (parent, child and new sibling) are pinned at any time.
+ * Leaves are not linked: with copy-on-write a link would force the left neighbour to be copied
+ * too, so `scan` moves to the next leaf through the path from the root instead.
+ */
+class PagedBTree {
+private:
+    struct Metadata {
+        uint64_t magic;
+        uint64_t sequence;
+        uint64_t keyCount;
+        uint32_t pageSize;
+        PageId root;
+        PageId pageCount;
+        PageId freeList; // First free-list page, or NO_PAGE
+        uint64_t checksum;
+    };
+
+    struct NodeHeader {
+        uint32_t leaf;
+        uint32_t n;
+        uint32_t reserved[2];
+    };
+
+    struct FreeListHeader {
+        PageId next;
+        uint32_t count; // Number of free page IDs that follow the header
+    };
+
+    static const uint64_t MAGIC = 0x3145455254425047ull; // "GPBTREE1"
+
+    // Pins a page for the lifetime of the object
+    class PinnedPage {
+    private:
+        BufferPool& pool;
+        bool dirty;
+
+    public:
+        PageId id;
+        char* data;
+
+        PinnedPage(BufferPool& _pool, PageId _id, bool fresh = false)
+            : pool(_pool), dirty(fresh), id(_id), data(fresh ? _pool.pinNew(_id) : _pool.pin(_id)) {}
+
+        ~PinnedPage() {
+            pool.unpin(id, dirty);
+        }
+
+        PinnedPage(const PinnedPage&) = delete;
+        PinnedPage& operator=(const PinnedPage&) = delete;
+
+        void markDirty() {
+            dirty = true;
+        }
+
+        NodeHeader& header() {
+            return *(NodeHeader*)data;
+        }
+
+        int32_t* keys() {
+            return (int32_t*)(data + sizeof(NodeHeader));
+        }
+    };
+
+    PageFile file;
+    Metadata meta;
+    int activeSlot;
+    bool existed;
+    uint32_t leafCapacity, innerCapacity, freeListCapacity;
+    std::unique_ptr<BufferPool> pool;
+    std::unordered_set<PageId> fresh; // Pages allocated since the last checkpoint: updated in place
+    std::vector<PageId> retired;      // Pages replaced by a copy since the last checkpoint
+    std::vector<PageId> freePages;    // Free pages already read into memory
+    PageId unreadFreeList;            // First free-list page not yet read, or NO_PAGE
+    std::vector<PageId> readFreeList; // Free-list pages read so far: in use until the next checkpoint
+
+    static uint64_t checksumOf(const Metadata& m) {
+        uint64_t hash = 1469598103934665603ull; // FNV-1a over every field before the checksum
+        const unsigned char* bytes = (const unsigned char*)&m;
+        for (size_t i = 0; i < offsetof(Metadata, checksum); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    int32_t* values(PinnedPage& leaf) {
+        return leaf.keys() + leafCapacity;
+    }
+
+    PageId* children(PinnedPage& node) {
+        return (PageId*)(node.keys() + innerCapacity);
+    }
+
+    uint32_t capacity(PinnedPage& node) {
+        return node.header().leaf ? leafCapacity : innerCapacity;
+    }
+
+    // Function to find the child whose subtree may contain k (number of separators <= k)
+    static uint32_t childIndex(PinnedPage& node, int k) {
+        uint32_t lo = 0, hi = node.header().n;
+        const int32_t* keys = node.keys();
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (keys[mid] <= k) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Function to find the index of the first key greater than or equal to k
+    static uint32_t lowerBound(PinnedPage& node, int k) {
+        uint32_t lo = 0, hi = node.header().n;
+        const int32_t* keys = node.keys();
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (keys[mid] < k) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    /*
+     * Function to move the free page IDs of the next unread free-list page into `freePages`.
+     * The free-list page itself stays in use: the last checkpoint still references it.
+     * Throws runtime_error if the page holds an invalid count or page ID.
+     */
+    void readFreeListPage() {
+        PinnedPage list(*pool, unreadFreeList);
+        const FreeListHeader& h = *(const FreeListHeader*)list.data;
+        const PageId* ids = (const PageId*)(list.data + sizeof(FreeListHeader));
+        if (h.count > freeListCapacity || h.next >= meta.pageCount) {
+            throw std::runtime_error("PagedBTree metadata corrupt: bad free-list page");
+        }
+        for (uint32_t i = 0; i < h.count; i++) {
+            if (ids[i] == NO_PAGE || ids[i] >= meta.pageCount) {
+                throw std::runtime_error("PagedBTree metadata corrupt: bad free page");
+            }
+            freePages.push_back(ids[i]);
+        }
+        readFreeList.push_back(unreadFreeList);
+        unreadFreeList = h.next;
+    }
+
+    // Function to get a page for new contents: a free page if there is one, else a new one at the end
+    PageId allocatePage() {
+        PageId page;
+        while (freePages.empty() && unreadFreeList != NO_PAGE) {
+            readFreeListPage();
+        }
+        if (!freePages.empty()) {
+            page = freePages.back();
+            freePages.pop_back();
+        } else {
+            page = meta.pageCount++;
+        }
+        fresh.insert(page);
+        return page;
+    }
+
+    /*
+     * Function to get a page that may be modified in place holding the contents of `page`.
+     * A page allocated since the last checkpoint is returned as is; any other page belongs to
+     * the checkpointed tree, so it is copied to a new page and retired until the next checkpoint.
+     * The caller stores the returned ID in the parent (or the root).
+     */
+    PageId makeWritable(PageId page) {
+        if (fresh.count(page) != 0) {
+            return page;
+        }
+        PageId copy = allocatePage();
+        PinnedPage source(*pool, page);
+        PinnedPage target(*pool, copy, true);
+        memcpy(target.data, source.data, meta.pageSize);
+        retired.push_back(page);
+        return copy;
+    }
+
+    // Function to descend from the root to the leaf that may contain k
+    PageId findLeaf(int k) {
+        PageId page = meta.root;
+        while (true) {
+            PinnedPage node(*pool, page);
+            if (node.header().leaf) {
+                return page;
+            }
+            page = children(node)[childIndex(node, k)];
+        }
+    }
+
+    /*
+     * Function to split the full child at index i of `parent`.
+     * A leaf keeps the lower half, the upper half moves to a new leaf linked after it and the
+     * new leaf's first key is copied up. An internal node moves its middle key up.
+     */
+    void splitChild(PinnedPage& parent, uint32_t i, PinnedPage& child) {
+        PinnedPage sibling(*pool, allocatePage(), true);
+        NodeHeader& y = child.header();
+        NodeHeader& z = sibling.header();
+        z.leaf = y.leaf;
+        uint32_t mid = y.n / 2;
+        int separator;
+
+        if (y.leaf) {
+            z.n = y.n - mid;
+            memcpy(sibling.keys(), child.keys() + mid, z.n * sizeof(int32_t));
+            memcpy(values(sibling), values(child) + mid, z.n * sizeof(int32_t));
+            separator = sibling.keys()[0];
+        } else {
+            z.n = y.n - mid - 1;
+            memcpy(sibling.keys(), child.keys() + mid + 1, z.n * sizeof(int32_t));
+            memcpy(children(sibling), children(child) + mid + 1, (z.n + 1) * sizeof(PageId));
+            separator = child.keys()[mid];
+        }
+        y.n = mid;
+        child.markDirty();
+
+        NodeHeader& p = parent.header();
+        int32_t* parentKeys = parent.keys();
+        PageId* parentChildren = children(parent);
+        memmove(parentKeys + i + 1, parentKeys + i, (p.n - i) * sizeof(int32_t));
+        memmove(parentChildren + i + 2, parentChildren + i + 1, (p.n - i) * sizeof(PageId));
+        parentKeys[i] = separator;
+        parentChildren[i + 1] = sibling.id;
+        p.n++;
+        parent.markDirty();
+    }
+
+public:
+    /*
+     * Constructor: opens the index in `path`, or creates an empty one with pages of
+     * `pageSize` bytes (a power of two from 4 KB to 64 KB) if the file is new or empty.
+     * `poolFrames` is the number of pages the buffer pool keeps in memory.
+     * Throws runtime_error if a non-empty file has no valid metadata slot (not an index, or
+     * both slots corrupt); such a file is left untouched.
+     */
+    PagedBTree(const std::string& path, uint32_t pageSize = 4096, size_t poolFrames = 256)
+        : file(path), activeSlot(0), existed(false), unreadFreeList(NO_PAGE) {
+        // Pick the valid metadata slot with the highest sequence number
+        char slot[METADATA_SLOT_BYTES];
+        for (int s = 0; s < 2; s++) {
+            file.readMetadataSlot(s, slot);
+            Metadata m;
+            memcpy(&m, slot, sizeof(Metadata));
+            if (m.magic == MAGIC && m.checksum == checksumOf(m) && (!existed || m.sequence > meta.sequence)) {
+                meta = m;
+                activeSlot = s;
+                existed = true;
+            }
+        }
+
+        if (!existed && file.size() != 0) {
+            throw std::runtime_error(path + " is not a PagedBTree index or its metadata is corrupt");
+        }
+        if (!existed) {
+            if (pageSize < MIN_PAGE_SIZE || pageSize > MAX_PAGE_SIZE || (pageSize & (pageSize - 1)) != 0) {
+                throw std::invalid_argument("page size must be a power of two from 4096 to 65536");
+            }
+            memset(&meta, 0, sizeof(Metadata));
+            meta.magic = MAGIC;
+            meta.pageSize = pageSize;
+            meta.pageCount = 1; // Page 0 is the metadata page
+            activeSlot = 1;     // The first checkpoint writes slot 0
+        }
+
+        file.pageSize = meta.pageSize;
+        leafCapacity = (meta.pageSize - sizeof(NodeHeader)) / (2 * sizeof(int32_t));
+        innerCapacity = (meta.pageSize - sizeof(NodeHeader) - sizeof(PageId)) / (sizeof(int32_t) + sizeof(PageId));
+        freeListCapacity = (meta.pageSize - sizeof(FreeListHeader)) / sizeof(PageId);
+        pool.reset(new BufferPool(file, poolFrames < 4 ? 4 : poolFrames));
+
+        if (!existed) {
+            meta.root = allocatePage();
+            {
+                PinnedPage root(*pool, meta.root, true);
+                root.header().leaf = 1;
+            }
+            checkpoint();
+        } else {
+            if (meta.root == NO_PAGE || meta.root >= meta.pageCount || meta.freeList >= meta.pageCount) {
+                throw std::runtime_error(path + " is not a PagedBTree index or its metadata is corrupt");
+            }
+            unreadFreeList = meta.freeList;
+        }
+    }
+
+    // Destructor: checkpoints, so everything inserted before closing is durable
+    ~PagedBTree() {
+        try {
+            checkpoint();
+        } catch (const std::exception&) {
+            // The last checkpoint stays in effect
+        }
+    }
+
+    PagedBTree(const PagedBTree&) = delete;
+    PagedBTree& operator=(const PagedBTree&) = delete;
+
+    /*
+     * Function to make the current tree durable: write the free pages into new free-list pages,
+     * write back all dirty pages, sync them, then switch the root by writing the other metadata
+     * slot and syncing again. The pages retired since the previous checkpoint and the free-list
+     * pages already read become free once the new root is durable. Free-list pages not read yet
+     * are not rewritten: the new list ends with them.
+     */
+    void checkpoint() {
+        Metadata next = meta;
+        next.sequence = meta.sequence + 1;
+
+        // The new free-list pages must not overwrite anything the last checkpoint references,
+        // so they come from the free pages (or the end of the file), not from the released pages
+        std::vector<PageId> released(retired);
+        released.insert(released.end(), readFreeList.begin(), readFreeList.end());
+        std::vector<PageId> available(freePages);
+        std::vector<PageId> listPages;
+        while ((uint64_t)listPages.size() * freeListCapacity < available.size() + released.size()) {
+            if (!available.empty()) {
+                listPages.push_back(available.back());
+                available.pop_back();
+            } else {
+                listPages.push_back(next.pageCount++);
+            }
+        }
+        available.insert(available.end(), released.begin(), released.end());
+
+        size_t written = 0;
+        for (size_t j = 0; j < listPages.size(); j++) {
+            PinnedPage list(*pool, listPages[j], true);
+            FreeListHeader& h = *(FreeListHeader*)list.data;
+            h.next = j + 1 < listPages.size() ? listPages[j + 1] : unreadFreeList;
+            h.count = (uint32_t)std::min<size_t>(freeListCapacity, available.size() - written);
+            memcpy(list.data + sizeof(FreeListHeader), available.data() + written, h.count * sizeof(PageId));
+            written += h.count;
+        }
+        next.freeList = listPages.empty() ? unreadFreeList : listPages[0];
+
+        pool->flushAll(); // Only pages allocated since the last checkpoint can be dirty
+        file.sync();
+
+        next.checksum = checksumOf(next);
+        char slot[METADATA_SLOT_BYTES];
+        memset(slot, 0, sizeof(slot));
+        memcpy(slot, &next, sizeof(Metadata));
+        file.writeMetadataSlot(1 - activeSlot, slot);
+        file.sync();
+
+        meta = next;
+        activeSlot = 1 - activeSlot;
+        freePages.swap(available);
+        readFreeList.swap(listPages); // Already in memory, so treated as read
+        retired.clear();
+        fresh.clear();
+    }
+
+    // Function to look up a key; stores its value and returns true if it is present
+    bool search(int k, int& value) {
+        PinnedPage leaf(*pool, findLeaf(k));
+        uint32_t i = lowerBound(leaf, k);
+        if (i < leaf.header().n && leaf.keys()[i] == k) {
+            value = values(leaf)[i];
+            return true;
+        }
+        return false;
+    }
+
+    // Function to insert a key with a value; an existing key gets the new value
+    void insert(int k, int value) {
+        // Every page on the path is made writable before it is changed (copy-on-write)
+        meta.root = makeWritable(meta.root);
+        {
+            PinnedPage root(*pool, meta.root);
+            if (root.header().n == capacity(root)) { // Root is full: the tree grows by one level
+                PinnedPage newRoot(*pool, allocatePage(), true);
+                children(newRoot)[0] = root.id;
+                meta.root = newRoot.id;
+                splitChild(newRoot, 0, root);
+            }
+        }
+
+        PageId page = meta.root;
+        while (true) {
+            PinnedPage node(*pool, page);
+            if (node.header().leaf) {
+                NodeHeader& h = node.header();
+                uint32_t i = lowerBound(node, k);
+                if (i < h.n && node.keys()[i] == k) {
+                    values(node)[i] = value;
+                } else {
+                    memmove(node.keys() + i + 1, node.keys() + i, (h.n - i) * sizeof(int32_t));
+                    memmove(values(node) + i + 1, values(node) + i, (h.n - i) * sizeof(int32_t));
+                    node.keys()[i] = k;
+                    values(node)[i] = value;
+                    h.n++;
+                    meta.keyCount++;
+                }
+                node.markDirty();
+                return;
+            }
+
+            uint32_t i = childIndex(node, k);
+            PageId writable = makeWritable(children(node)[i]);
+            if (writable != children(node)[i]) {
+                children(node)[i] = writable;
+                node.markDirty();
+            }
+            PinnedPage child(*pool, writable);
+            if (child.header().n == capacity(child)) {
+                splitChild(node, i, child);
+                if (node.keys()[i] <= k) {
+                    i++;
+                }
+            }
+            page = children(node)[i];
+        }
+    }
+
+    /*
+     * Function to get all (key, value) pairs with lo <= key <= hi in key order.
+     * Keeps the path from the root; after a leaf, it climbs to the nearest ancestor with a
+     * child to the right and descends to that child's leftmost leaf.
+     */
+    std::vector<std::pair<int, int>> scan(int lo, int hi) {
+        std::vector<std::pair<int, int>> result;
+        if (lo > hi) {
+            return result;
+        }
+        std::vector<std::pair<PageId, uint32_t>> path; // (internal node, index of the next child to visit)
+        PageId page = meta.root;
+        while (true) {
+            PinnedPage node(*pool, page);
+            if (node.header().leaf) {
+                break;
+            }
+            uint32_t i = childIndex(node, lo);
+            path.push_back({page, i + 1});
+            page = children(node)[i];
+        }
+
+        while (true) {
+            {
+                PinnedPage leaf(*pool, page);
+                for (uint32_t i = lowerBound(leaf, lo); i < leaf.header().n; i++) {
+                    if (leaf.keys()[i] > hi) {
+                        return result;
+                    }
+                    result.push_back({leaf.keys()[i], values(leaf)[i]});
+                }
+            }
+
+            // Climb to the nearest ancestor that has a child to the right of the path
+            page = NO_PAGE;
+            while (!path.empty()) {
+                PinnedPage node(*pool, path.back().first);
+                if (path.back().second <= node.header().n) {
+                    page = children(node)[path.back().second++];
+                    break;
+                }
+                path.pop_back();
+            }
+            if (page == NO_PAGE) {
+                return result;
+            }
+
+            // Descend to that child's leftmost leaf
+            while (true) {
+                PinnedPage node(*pool, page);
+                if (node.header().leaf) {
+                    break;
+                }
+                path.push_back({page, 1});
+                page = children(node)[0];
+            }
+        }
+    }
+
+    // Function to get the number of keys in the tree
+    uint64_t size() const {
+        return meta.keyCount;
+    }
+
+    // Function to check whether the index already existed when it was opened
+    bool reopened() const {
+        return existed;
+    }
+
+    uint32_t pageSize() const {
+        return meta.pageSize;
+    }
+
+    // Function to get the buffer pool counters (hits, page reads, page writes)
+    const BufferPool& bufferPool() const {
+        return *pool;
+    }
+};
+
+} // namespace btree
+
+#endif
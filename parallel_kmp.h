@@ -0,0 +1,146 @@
+#ifndef PARALLEL_KMP_H
+#define PARALLEL_KMP_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include "kmp_prefilter.h"
+
+namespace kmp {
+
+/*
+ * Parallel KMP search of a text in memory.
+ * The text is split into one chunk per thread. A chunk owns the match positions in
+ * [begin, end) and searches text[begin, end + m - 1): the m - 1 extra bytes are the
+ * overlap with the next chunk, so a match crossing the boundary is found by the chunk
+ * it starts in, and by no other. Concatenating the chunks' matches in chunk order
+ * therefore gives all matches in order without duplicates, and no merge step is needed.
+ * Each chunk is searched with `PrefilteredKMP` (kmp_prefilter.h), one block at a time, so
+ * that a thread can notice cancellation between blocks.
+ * Modes:
+ *  - `findAll`: Every match position.
+ *  - `count`: Only the number of matches; nothing is stored.
+ *  - `findFirst`: The first `limit` matches. Every chunk publishes how many matches it has
+ *    found so far; a chunk stops as soon as it has `limit` matches itself, or the chunks
+ *    before it have `limit` matches together, since none of its own can then be among the
+ *    first `limit`.
+ */
+class ParallelKMP {
+private:
+    PrefilteredKMP matcher;
+    size_t m;
+    int threads;
+
+    // Bytes a thread searches between two checks for cancellation
+    static const size_t BLOCK_BYTES = 1 << 20;
+
+    // Smallest chunk worth a thread of its own
+    static const size_t MIN_CHUNK_BYTES = 1 << 16;
+
+    /*
+     * Function to search chunk `c` of `chunks` and store or count its matches.
+     * `found` holds the number of matches each chunk has found so far.
+     */
+    void searchChunk(const char* text, size_t n, int c, int chunks, size_t limit, bool store,
+                     std::vector<size_t>& matches, std::atomic<size_t>* found) const {
+        size_t begin = n / chunks * c;
+        size_t end = (c == chunks - 1) ? n : n / chunks * (c + 1);
+        size_t own = 0;
+        for (size_t block = begin; block < end; block += BLOCK_BYTES) {
+            // Stop once the earlier chunks already hold the first `limit` matches
+            size_t before = 0;
+            for (int earlier = 0; earlier < c && before < limit; earlier++) {
+                before += found[earlier].load(std::memory_order_relaxed);
+            }
+            if (before >= limit || own >= limit) {
+                break;
+            }
+            size_t blockEnd = std::min(end, block + BLOCK_BYTES);
+            size_t scanEnd = std::min(n, blockEnd + m - 1);
+            matcher.search(text + block, scanEnd - block, [&](size_t position) {
+                if (block + position < blockEnd && own < limit) { // Positions past blockEnd belong to the next block
+                    if (store) matches.push_back(block + position);
+                    own++;
+                }
+            });
+            found[c].store(own, std::memory_order_relaxed);
+        }
+    }
+
+    // Function to run all chunks on their threads; returns the matches of each chunk
+    std::vector<std::vector<size_t>> run(const char* text, size_t n, size_t limit, bool store, size_t& total) const {
+        int chunks = (int)std::max<size_t>(1, std::min<size_t>(threads, n / MIN_CHUNK_BYTES));
+        std::vector<std::vector<size_t>> matches(chunks);
+        std::unique_ptr<std::atomic<size_t>[]> found(new std::atomic<size_t>[chunks]);
+        for (int c = 0; c < chunks; c++) {
+            found[c].store(0);
+        }
+
+        std::vector<std::thread> workers;
+        for (int c = 1; c < chunks; c++) {
+            workers.emplace_back([&, c]() { searchChunk(text, n, c, chunks, limit, store, matches[c], found.get()); });
+        }
+        searchChunk(text, n, 0, chunks, limit, store, matches[0], found.get());
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        total = 0;
+        for (int c = 0; c < chunks; c++) {
+            total += found[c].load();
+        }
+        return matches;
+    }
+
+    // Function to concatenate the chunks' matches in order, keeping at most `limit`
+    static std::vector<size_t> concatenate(const std::vector<std::vector<size_t>>& chunks, size_t limit) {
+        std::vector<size_t> result;
+        for (const std::vector<size_t>& chunk : chunks) {
+            size_t take = std::min(chunk.size(), limit - result.size());
+            result.insert(result.end(), chunk.begin(), chunk.begin() + take);
+            if (result.size() == limit) break;
+        }
+        return result;
+    }
+
+public:
+    // Constructor: threads <= 0 means one per hardware thread; throws invalid_argument for an empty pattern
+    explicit ParallelKMP(const std::string& pattern, int _threads = 0)
+        : matcher(pattern), m(pattern.size()), threads(_threads) {
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    // Function to get all match positions in text[0 .. n), in order
+    std::vector<size_t> findAll(const char* text, size_t n) const {
+        size_t total;
+        return concatenate(run(text, n, SIZE_MAX, true, total), SIZE_MAX);
+    }
+
+    // Function to count the matches in text[0 .. n)
+    size_t count(const char* text, size_t n) const {
+        size_t total;
+        run(text, n, SIZE_MAX, false, total);
+        return total;
+    }
+
+    // Function to get the first `limit` match positions in text[0 .. n), cancelling work past them
+    std::vector<size_t> findFirst(const char* text, size_t n, size_t limit) const {
+        if (limit == 0) return {};
+        size_t total;
+        return concatenate(run(text, n, limit, true, total), limit);
+    }
+
+    int threadCount() const {
+        return threads;
+    }
+};
+
+} // namespace kmp
+
+#endif
@@ -1,196 +1,175 @@
 #include <iostream>
+#include <vector>
+#include <utility>
+#include <string>
+#include <stdexcept>
+#include "btree.h"
+#include "paged_btree.h"
+#include "fast_io.h"
 using namespace std;
+using namespace btree;
+using namespace fast_io;
 
 /*
- * A B-Tree node structure.
- * Contains:
- *  - `keys`: Array of keys in the node.
- *  - `t`: Minimum degree of the B-Tree (defines the range for the number of keys).
- *  - `children`: Array of child pointers.
- *  - `n`: Current number of keys in the node.
- *  - `leaf`: Boolean to indicate if the node is a leaf.
+ * Function to run the paged B+ Tree mode: opens (or creates) an index file, inserts, searches
+ * and scans, then checkpoints so that the next run reopens the same index without a rebuild.
  */
-class BTreeNode {
-public:
-    int* keys;          // Array of keys
-    int t;              // Minimum degree
-    BTreeNode** children; // Array of child pointers
-    int n;              // Current number of keys
-    bool leaf;          // True if the node is a leaf
-
-    // Constructor for BTreeNode
-    BTreeNode(int _t, bool _leaf);
-
-    // Function to traverse all nodes in a subtree rooted at this node
-    void traverse();
-
-    // Function to insert a new key in a non-full node
-    void insertNonFull(int k);
-
-    // Function to split the child of this node
-    void splitChild(int i, BTreeNode* y);
+int runPagedTree(FastReader& in, FastWriter& out) {
+    out.prompt("Enter the index file path: ");
+    string path = in.nextWord();
+    out.prompt("Enter the page size in KB for a new index (4 or 16): ");
+    int pageKB = in.next<int>();
+
+    try {
+        PagedBTree tree(path, pageKB * 1024);
+        if (tree.reopened()) {
+            out << "Opened existing index with " << tree.size() << " keys\n";
+        } else {
+            out << "Created a new index with " << tree.pageSize() << "-byte pages\n";
+        }
 
-    // Friend class for accessing private members
-    friend class BTree;
-};
+        out.prompt("Enter the number of keys to insert: ");
+        int n = in.next<int>();
+        if (n > 0) {
+            out.prompt("Enter the keys and values (key value): ");
+        }
+        for (int i = 0; i < n; i++) {
+            int key = in.next<int>();
+            int value = in.next<int>();
+            tree.insert(key, value);
+        }
 
-/*
- * A B-Tree class.
- * Contains:
- *  - Root node.
- *  - Minimum degree (t).
- */
-class BTree {
-private:
-    BTreeNode* root; // Pointer to the root node
-    int t;           // Minimum degree
-
-public:
-    // Constructor for BTree
-    BTree(int _t) {
-        root = nullptr;
-        t = _t;
-    }
+        out.prompt("Enter the number of keys to search: ");
+        int m = in.next<int>();
+        if (m > 0) {
+            out.prompt("Enter the keys: ");
+        }
+        for (int i = 0; i < m; i++) {
+            int key = in.next<int>(), value;
+            if (tree.search(key, value)) {
+                out << key << " found with value " << value << '\n';
+            } else {
+                out << key << " not found\n";
+            }
+        }
 
-    // Function to traverse the tree
-    void traverse() {
-        if (root != nullptr) {
-            root->traverse();
+        out.prompt("Enter a key range to scan (lo hi): ");
+        int lo = in.next<int>();
+        int hi = in.next<int>();
+        out << "Keys in [" << lo << ", " << hi << "]:";
+        for (const pair<int, int>& entry : tree.scan(lo, hi)) {
+            out << " " << entry.first << "=" << entry.second;
         }
+        out << '\n';
+
+        tree.checkpoint();
+        out << "Index holds " << tree.size() << " keys (buffer pool: " << tree.bufferPool().hits << " hits, "
+            << tree.bufferPool().reads << " page reads, " << tree.bufferPool().writes << " page writes)\n";
+    } catch (const exception& e) {
+        out << "Paged B+ Tree failed: " << e.what() << '\n';
+        return 1;
     }
-
-    // Function to insert a new key
-    void insert(int k);
-};
-
-// Constructor for BTreeNode
-BTreeNode::BTreeNode(int _t, bool _leaf) {
-    t = _t;
-    leaf = _leaf;
-
-    keys = new int[2 * t - 1];         // Allocate memory for keys
-    children = new BTreeNode*[2 * t]; // Allocate memory for child pointers
-    n = 0;                            // Initialize the number of keys as 0
+    return 0;
 }
 
-// Function to traverse all nodes in a subtree
-void BTreeNode::traverse() {
-    int i;
-    for (i = 0; i < n; i++) {
-        if (!leaf) {
-            children[i]->traverse(); // Recursively visit child nodes
+int main(int argc, char* argv[]) {
+    try {
+        DriverOptions options = parseDriverOptions(argc, argv);
+        FastReader in(options.input);
+        FastWriter out(!options.batch);
+
+        out.prompt("Choose the tree:\n"
+                   "1. B-Tree\n"
+                   "2. B+ Tree (values in linked leaves, with range scan)\n"
+                   "3. Paged B+ Tree (index file on disk, kept between runs)\n"
+                   "Enter your choice: ");
+        int mode = in.next<int>();
+        if (mode < 1 || mode > 3) {
+            out << "Invalid choice!\n";
+            return 1;
+        }
+        if (mode == 3) {
+            return runPagedTree(in, out);
         }
-        cout << keys[i] << " "; // Print the key
-    }
-
-    if (!leaf) {
-        children[i]->traverse(); // Visit the last child
-    }
-}
 
-// Function to insert a new key in the B-Tree
-void BTree::insert(int k) {
-    if (root == nullptr) {
-        root = new BTreeNode(t, true); // Create a new root
-        root->keys[0] = k;            // Insert the key into the root
-        root->n = 1;                  // Update the number of keys
-    } else {
-        if (root->n == 2 * t - 1) { // Root is full
-            BTreeNode* newRoot = new BTreeNode(t, false); // Create a new root
-            newRoot->children[0] = root;                 // Make old root a child
+        out.prompt("Enter the minimum degree (t) of the B-Tree: ");
+        int t = in.next<int>();
+        if (t < 2) {
+            out << "The minimum degree must be at least 2!\n";
+            return 1;
+        }
 
-            newRoot->splitChild(0, root); // Split the old root
+        BTree bTree(t);
+        BPlusTree bPlusTree(t);
 
-            int i = (newRoot->keys[0] < k) ? 1 : 0; // Determine which subtree to go to
-            newRoot->children[i]->insertNonFull(k); // Insert in the appropriate subtree
+        out.prompt("Enter the number of keys to insert: ");
+        int n = in.next<int>();
 
-            root = newRoot; // Update root
+        if (mode == 1) {
+            out.prompt("Enter the keys: ");
+            for (int i = 0; i < n; i++) {
+                bTree.insert(in.next<int>());
+            }
         } else {
-            root->insertNonFull(k); // Insert in the non-full root
-        }
-    }
-}
-
-// Function to insert a key in a non-full node
-void BTreeNode::insertNonFull(int k) {
-    int i = n - 1; // Index of the rightmost key
-
-    if (leaf) {
-        while (i >= 0 && keys[i] > k) { // Find location for new key
-            keys[i + 1] = keys[i]; // Shift keys to make space
-            i--;
+            out.prompt("Enter the keys and values (key value): ");
+            for (int i = 0; i < n; i++) {
+                int key = in.next<int>();
+                int value = in.next<int>();
+                bPlusTree.insert(key, value);
+            }
         }
 
-        keys[i + 1] = k; // Insert the new key
-        n++;             // Update the number of keys
-    } else {
-        while (i >= 0 && keys[i] > k) {
-            i--; // Find child to descend
+        out.prompt("Enter the number of keys to search: ");
+        int m = in.next<int>();
+        if (m > 0) {
+            out.prompt("Enter the keys: ");
         }
-
-        if (children[i + 1]->n == 2 * t - 1) { // Child is full
-            splitChild(i + 1, children[i + 1]); // Split the child
-
-            if (keys[i + 1] < k) {
-                i++;
+        for (int i = 0; i < m; i++) {
+            int key = in.next<int>(), value;
+            if (mode == 1) {
+                out << key << (bTree.search(key) != nullptr ? " found" : " not found") << '\n';
+            } else if (bPlusTree.search(key, value)) {
+                out << key << " found with value " << value << '\n';
+            } else {
+                out << key << " not found\n";
             }
         }
-        children[i + 1]->insertNonFull(k); // Recur for the appropriate child
-    }
-}
 
-// Function to split a full child
-void BTreeNode::splitChild(int i, BTreeNode* y) {
-    BTreeNode* z = new BTreeNode(y->t, y->leaf); // Create a new node
-    z->n = t - 1;                               // Update the number of keys in the new node
-
-    for (int j = 0; j < t - 1; j++) {
-        z->keys[j] = y->keys[j + t]; // Move the last (t-1) keys to the new node
-    }
-
-    if (!y->leaf) {
-        for (int j = 0; j < t; j++) {
-            z->children[j] = y->children[j + t]; // Move the child pointers
+        out.prompt("Enter the number of keys to remove: ");
+        m = in.next<int>();
+        if (m > 0) {
+            out.prompt("Enter the keys: ");
+        }
+        for (int i = 0; i < m; i++) {
+            int key = in.next<int>();
+            bool removed = (mode == 1) ? bTree.remove(key) : bPlusTree.remove(key);
+            out << key << (removed ? " removed" : " not found") << '\n';
         }
-    }
-
-    y->n = t - 1; // Update the number of keys in the old node
-
-    for (int j = n; j >= i + 1; j--) {
-        children[j + 1] = children[j]; // Shift children to make space
-    }
-
-    children[i + 1] = z; // Link the new child
-
-    for (int j = n - 1; j >= i; j--) {
-        keys[j + 1] = keys[j]; // Shift keys to make space
-    }
-
-    keys[i] = y->keys[t - 1]; // Move a key from the old node to the parent
-    n++;                      // Increment the number of keys
-}
-
-int main() {
-    int t, n;
-    cout << "Enter the minimum degree (t) of the B-Tree: ";
-    cin >> t;
-
-    BTree bTree(t);
-
-    cout << "Enter the number of keys to insert: ";
-    cin >> n;
 
-    cout << "Enter the keys: ";
-    for (int i = 0; i < n; i++) {
-        int key;
-        cin >> key;
-        bTree.insert(key);
+        out << "Traversal of the B-Tree: ";
+        if (mode == 1) {
+            bTree.traverse(out);
+        } else {
+            bPlusTree.traverse(out);
+        }
+        out << '\n';
+
+        if (mode == 2) {
+            out.prompt("Enter a key range to scan (lo hi): ");
+            int lo = in.next<int>();
+            int hi = in.next<int>();
+            out << "Keys in [" << lo << ", " << hi << "]:";
+            for (const pair<int, int>& entry : bPlusTree.scan(lo, hi)) {
+                out << " " << entry.first << "=" << entry.second;
+            }
+            out << '\n';
+        }
+        out.flush();
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
     }
 
-    cout << "Traversal of the B-Tree: ";
-    bTree.traverse();
-    cout << endl;
-
     return 0;
 }
 /*
@@ -202,32 +181,66 @@ int main() {
  * Key Concepts:
  *  - A B-Tree node contains a range of keys (up to 2t-1) and child pointers (up to 2t).
  *  - Keys are stored in sorted order, and nodes are split when they become full.
+ *  - Removal keeps every node except the root at t-1 keys or more: before descending into a
+ *    child with only t-1 keys, it borrows a key from a sibling or merges with one.
+ *  - In the B+ Tree, values are stored only in the leaves and the leaves form a linked list,
+ *    so a range scan descends once and then reads leaves sequentially.
  *
- * Functions:
+ * Functions (btree.h, except `runPagedTree`):
  *  1. `insert`: Handles the insertion of a key, splitting nodes as needed.
- *  2. `traverse`: Recursively traverses and prints the B-Tree in sorted order.
+ *  2. `traverse`: Recursively traverses the B-Tree and writes its keys in sorted order to a stream.
  *  3. `insertNonFull`: Inserts a key in a node that is not full.
  *  4. `splitChild`: Splits a full child node into two nodes and moves a key to the parent.
+ *  5. `search`: Descends from the root to the node holding a key.
+ *  6. `remove`: Removes a key, replacing an internal key by its predecessor or successor.
+ *  7. `fill`, `borrowFromPrev`, `borrowFromNext`, `merge`: Refill a child that has too few keys.
+ *  8. `BPlusTree`: B+ Tree with `insert`, `search`, `remove` and `scan(lo, hi)`.
+ *  9. `PagedBTree` (paged_btree.h): B+ Tree in fixed-size file pages behind a CLOCK buffer pool,
+ *     with copy-on-write pages and double-slot metadata, so a crash leaves the last
+ *     checkpoint intact; `runPagedTree` drives it.
+ * 10. `bulkLoad`: Builds the tree bottom-up from sorted keys with a configurable fill factor.
+ * 11. `appendKey`: Fast path of `insert` for keys not smaller than the current maximum; writes
+ *     into the rightmost leaf through a cached right spine and splits the right edge 90/10.
  *
  * Input:
+ *  - The tree to use (1 = B-Tree, 2 = B+ Tree, 3 = Paged B+ Tree, which asks for an index file
+ *    and a page size instead of `t`, and has no remove step).
  *  - Minimum degree (`t`) of the B-Tree.
- *  - Number of keys and the keys to insert.
+ *  - Number of keys and the keys to insert (for the B+ Tree, key and value pairs).
+ *  - Keys to search for and keys to remove.
+ *  - For the B+ Tree, a key range to scan.
+ *  - With `--batch [file]` the same values are read without prompts from the file (or from
+ *    standard input).
  *
  * Output:
- *  - Traversal of the B-Tree after all keys are inserted.
+ *  - Whether each key was found or removed.
+ *  - Traversal of the B-Tree after all keys are inserted and removed.
+ *  - For the B+ Tree, the (key, value) pairs in the scanned range.
  *
  * Complexity:
  *  - Time Complexity:
  *     * Search: O(log n)
  *     * Insertion: O(log n)
  *     * Deletion: O(log n)
+ *     * Range scan (B+ Tree): O(log n + k) for k keys in the range.
+ *     * Bulk load: O(n); ascending inserts: O(1) amortized each through the append path.
+ *     * Paged B+ Tree: O(log_B n) page accesses per operation for B keys per page; reopening
+ *       reads only the metadata slots.
  *  - Space Complexity: O(n)
  *
  * Example:
  *  - Input:
+ *     Enter your choice: 1
  *     Enter the minimum degree (t) of the B-Tree: 3
  *     Enter the number of keys to insert: 7
  *     Enter the keys: 10 20 5 6 12 30 7
+ *     Enter the number of keys to search: 2
+ *     Enter the keys: 12 15
+ *     Enter the number of keys to remove: 1
+ *     Enter the keys: 10
  *  - Output:
- *     Traversal of the B-Tree: 5 6 7 10 12 20 30
+ *     12 found
+ *     15 not found
+ *     10 removed
+ *     Traversal of the B-Tree: 5 6 7 12 20 30
  */
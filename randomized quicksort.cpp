@@ -1,83 +1,153 @@
 #include <iostream>
 #include <vector>
-#include <cstdlib>
-#include <ctime>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include "randomized_quicksort.h"
+#include "fast_io.h"
 using namespace std;
+using namespace quicksort;
+using namespace fast_io;
+using namespace sort_counters;
 
-// Global variable to count comparisons
-int comparisonCount = 0;
-
-// Function to swap two elements
-void swap(int& a, int& b) {
-    int temp = a;
-    a = b;
-    b = temp;
+// Function to print the array
+void printArray(FastWriter& out, const vector<int>& arr) {
+    for (int num : arr) {
+        out << num << ' ';
+    }
+    out << '\n';
 }
 
-// Function to partition the array around a pivot
-int partition(vector<int>& arr, int low, int high) {
-    int pivot = arr[high]; // Pivot element
-    int i = low - 1; // Index of smaller element
+/*
+ * Strong-scaling benchmark for the parallel sort.
+ * Sorts the same random array of `n` integers with 1, 2, 4, ..., 64 threads and
+ * prints time, speedup and parallel efficiency relative to the 1-thread run.
+ */
+void strongScalingBenchmark(int n, int grainSize) {
+    vector<int> input(n);
+    mt19937 rng(12345);
+    for (int& x : input) {
+        x = rng();
+    }
 
-    for (int j = low; j < high; j++) {
-        comparisonCount++; // Increment comparison count
-        if (arr[j] <= pivot) {
-            i++;
-            swap(arr[i], arr[j]);
+    cout << "Threads  Time (ms)  Speedup  Efficiency" << endl;
+    double baseline = 0;
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        vector<int> arr = input;
+        auto start = chrono::steady_clock::now();
+        parallelRandomizedQuickSort(arr, threads, grainSize);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (threads == 1) baseline = ms;
+
+        if (!is_sorted(arr.begin(), arr.end())) {
+            cout << "Error: output with " << threads << " threads is not sorted!" << endl;
+            return;
         }
+        cout << threads << "        " << ms << "  " << baseline / ms << "  " << baseline / ms / threads << endl;
     }
-    swap(arr[i + 1], arr[high]);
-    return i + 1;
 }
 
-// Function to randomize the pivot element
-int randomizedPartition(vector<int>& arr, int low, int high) {
-    srand(time(0)); // Seed for randomness
-    int randomPivot = low + rand() % (high - low + 1);
-    swap(arr[randomPivot], arr[high]); // Move random pivot to end
-    return partition(arr, low, high);
-}
+int main(int argc, char* argv[]) {
+    try {
+        DriverOptions options = parseDriverOptions(argc, argv);
+        FastReader in(options.input);
+        FastWriter out(!options.batch);
+
+        // Ask user for the sorting mode
+        out.prompt("Sorting modes:\n"
+                   "1. Randomized Quick Sort\n"
+                   "2. Parallel Randomized Quick Sort\n"
+                   "3. Strong-scaling benchmark (1 to 64 threads)\n"
+                   "4. Automatic selection (radix sort for large inputs)\n"
+                   "5. Automatic selection, in-place (low memory)\n"
+                   "6. External merge sort of a binary file\n"
+                   "Enter your choice: ");
+        int mode = in.next<int>();
+
+        if (mode < 1 || mode > 6) {
+            out << "Invalid choice.\n";
+            return 1;
+        }
 
-// Function to implement Quick Sort
-void randomizedQuickSort(vector<int>& arr, int low, int high) {
-    if (low < high) {
-        int pivotIndex = randomizedPartition(arr, low, high);
-        randomizedQuickSort(arr, low, pivotIndex - 1); // Sort left of pivot
-        randomizedQuickSort(arr, pivotIndex + 1, high); // Sort right of pivot
-    }
-}
+        if (mode == 6) {
+            out.prompt("Enter the input file (binary ints): ");
+            string inPath = in.nextWord();
+            out.prompt("Enter the output file: ");
+            string outPath = in.nextWord();
+            out.prompt("Enter the memory budget in MB: ");
+            size_t memoryMB = in.next<size_t>();
+            out.prompt("Enter the temp directory: ");
+            string tempDir = in.nextWord();
+
+            try {
+                externalSort(inPath, outPath, memoryMB << 20, tempDir);
+            } catch (const exception& e) {
+                out << "External sort failed: " << e.what() << '\n';
+                return 1;
+            }
+            out << "Sorted output written to " << outPath << '\n';
+            return 0;
+        }
 
-// Function to print the array
-void printArray(const vector<int>& arr) {
-    for (int num : arr) {
-        cout << num << " ";
-    }
-    cout << endl;
-}
+        int threads = thread::hardware_concurrency();
+        int grainSize = 1 << 14;
+        if (mode == 2 || mode == 3) {
+            out.prompt("Enter the grain size (ranges up to this size are sorted sequentially): ");
+            grainSize = in.next<int>();
+        }
 
-int main() {
-    // Ask user for input
-    int n;
-    cout << "Enter the number of elements: ";
-    cin >> n;
+        // Ask user for input
+        out.prompt("Enter the number of elements: ");
+        int n = in.next<int>();
+        if (n < 0) {
+            throw invalid_argument("The number of elements must not be negative");
+        }
 
-    vector<int> arr(n);
-    cout << "Enter the elements of the array: ";
-    for (int i = 0; i < n; i++) {
-        cin >> arr[i];
-    }
+        if (mode == 3) {
+            out.flush();
+            strongScalingBenchmark(n, grainSize);
+            return 0;
+        }
 
-    cout << "Original Array: ";
-    printArray(arr);
+        vector<int> arr(n);
+        out.prompt("Enter the elements of the array: ");
+        for (int i = 0; i < n; i++) {
+            arr[i] = in.next<int>();
+        }
 
-    // Sort the array using Randomized Quick Sort
-    randomizedQuickSort(arr, 0, n - 1);
+        out << "Original Array: ";
+        printArray(out, arr);
+
+        const char* algorithm = nullptr;
+        if (mode == 1) {
+            // Sort the array using Randomized Quick Sort
+            randomizedQuickSort(arr, 0, n - 1);
+        } else if (mode == 2) {
+            parallelRandomizedQuickSort(arr, threads, grainSize);
+        } else {
+            algorithm = autoSort(arr, mode == 5);
+        }
 
-    cout << "Sorted Array: ";
-    printArray(arr);
+        out << "Sorted Array: ";
+        printArray(out, arr);
 
-    // Report the number of comparisons
-    cout << "Number of Comparisons: " << comparisonCount << endl;
+#ifndef NO_SORT_COUNTERS
+        // Report the number of comparisons
+        if (mode == 1) {
+            out << "Number of Comparisons: " << readCounters().comparisons << '\n';
+        }
+#endif
+        if (algorithm != nullptr) {
+            out << "Algorithm used: " << algorithm << '\n';
+        }
+        out.flush();
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
+    }
 
     return 0;
 }
@@ -90,14 +160,29 @@ int main() {
  * Purpose:
  *  - This program sorts an array of integers using the Randomized Quick Sort algorithm.
  *  - The program also calculates and displays the number of comparisons made during sorting.
+ *    Comparisons, swaps and recursion depth are counted through `sort_counters.h`
+ *    (per-thread 64-bit counters, removed entirely with -DNO_SORT_COUNTERS).
+ *  - A parallel mode sorts on all cores using a work-stealing thread pool.
  *
  * Key Concepts:
  *  - Quick Sort is a divide-and-conquer algorithm that partitions the array into two subarrays
  *    around a pivot element and recursively sorts the subarrays.
  *  - Randomized Quick Sort improves the average performance by choosing a random pivot, reducing
  *    the chances of encountering the worst-case scenario.
+ *  - Work stealing: every thread owns a deque of tasks. It works on its newest task, and an idle
+ *    thread steals the oldest task of another thread, which is usually the largest one.
+ *  - The first partitions cover most of the array, so they are themselves split into blocks and
+ *    partitioned by all threads together instead of by a single thread.
+ *  - Radix sort orders integer keys digit by digit without comparisons. The LSD variant makes
+ *    one histogram pass plus one scatter pass per digit; the MSD (American flag) variant
+ *    permutes keys into their buckets in place and needs no extra buffer.
+ *  - External merge sort handles files larger than memory: sorted runs are written to disk and
+ *    merged in one pass (or several, if the budget cannot buffer every run) with a loser tree.
+ *    Each run is read through two buffers so the next block loads while the current one is merged.
+ *  - Tag sort: for large records only small (key, index) pairs are moved while sorting; the
+ *    records themselves are moved once at the end.
  *
- * Functions:
+ * Functions (randomized_quicksort.h, except `printArray` and `strongScalingBenchmark`):
  *  1. `swap`: Exchanges the values of two elements in the array.
  *  2. `partition`: Reorders the elements of the array such that all elements smaller than the pivot
  *     are on the left, and all greater elements are on the right.
@@ -105,19 +190,44 @@ int main() {
  *     element, then partitions the array around it.
  *  4. `randomizedQuickSort`: Recursively sorts the array by partitioning it around the pivot.
  *  5. `printArray`: Prints the elements of the array.
+ *  6. `hoarePartition` / `sequentialQuickSort`: Thread-safe sequential sort used for small ranges
+ *     in parallel mode (per-thread random generator, no shared counter).
+ *  7. `parallelPartition`: Partitions one range with all threads of the pool.
+ *  8. `parallelRandomizedQuickSort`: Parallel sort; ranges up to the grain size run sequentially.
+ *  9. `strongScalingBenchmark`: Times the parallel sort on a fixed input at 1 to 64 threads.
+ * 10. `lsdRadixSort`: LSD radix sort with 8- or 11-bit digits; digits shared by all keys are skipped.
+ * 11. `americanFlagSort`: In-place MSD radix sort for memory-constrained runs.
+ * 12. `autoSort`: Picks radix sort or a comparison sort based on the input size and key type.
+ * 13. `RunReader` / `RunWriter`: Double-buffered sequential I/O with asynchronous reads and writes.
+ * 14. `LoserTree`: Selects the smallest current key among k runs in O(log k) per key.
+ * 15. `externalSort`: Sorts a binary file within a memory budget using a temp directory; throws
+ *     `std::runtime_error` (after removing its run files) if the sort cannot complete.
+ * 16. `sortBy` / `tagSort` / `genericSort`: Templated sorts over any random-access range of records
+ *     with a comparator and a key projection. `tagSort` sorts (key, index) pairs and then moves
+ *     each record once by following the cycles of the permutation.
  *
  * Input:
+ *  - The program prompts the user for the sorting mode (and the grain size in parallel modes).
  *  - The program prompts the user to enter the number of elements and the array itself.
+ *    The benchmark mode only needs the number of elements and generates a random array.
+ *  - The external sort mode asks for input/output files, a memory budget and a temp directory.
+ *  - With `--batch [file]` the same values are read without prompts from the file (or from
+ *    standard input) through the buffered reader in fast_io.h.
  *
  * Output:
  *  - The sorted array in ascending order.
- *  - The number of comparisons made during sorting.
+ *  - The number of comparisons made during sorting (sequential mode).
+ *  - For the benchmark: time, speedup and efficiency for each thread count.
  *
  * Complexity:
  *  - Time Complexity:
  *     * Best/Average Case: O(n * log(n)) due to balanced partitions.
  *     * Worst Case: O(n^2) when partitions are highly imbalanced (rare with randomization).
+ *     * Parallel mode: O(n * log(n) / p + n) expected work per thread with p threads.
+ *     * Radix sort: O(n * w / b) for w-bit keys and b-bit digits.
+ *     * External sort: O(n * log(n)) comparisons and O(n / B * passes) block transfers.
  *  - Space Complexity: O(log(n)) due to recursive stack usage.
+ *     * LSD radix sort needs an O(n) buffer; the American flag sort needs O(w / 8) stack frames.
  *
  
  */
@@ -0,0 +1,1116 @@
+#ifndef RANDOMIZED_QUICKSORT_H
+#define RANDOMIZED_QUICKSORT_H
+
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+#include <future>
+#include <string>
+#include <cstdio>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <iterator>
+#include "sort_counters.h"
+
+/*
+ * Sorting algorithms of the randomized quick sort program.
+ * Contains:
+ *  - `randomizedQuickSort`: Quick sort with a random pivot and the Lomuto partition.
+ *  - `parallelRandomizedQuickSort`: Quick sort on a work-stealing thread pool.
+ *  - `lsdRadixSort`, `americanFlagSort`, `autoSort`: Radix sorts for integral keys, and the
+ *    dispatcher that picks one of them or a comparison sort.
+ *  - `sortBy`, `tagSort`, `genericSort`: Sorts of records by a projected key.
+ *  - `externalSort`: External merge sort of binary files larger than memory.
+ * Comparisons, swaps and recursion depth are counted through sort_counters.h.
+ */
+namespace quicksort {
+
+// Function to swap two elements
+inline void swap(int& a, int& b) {
+    COUNT_SWAP();
+    int temp = a;
+    a = b;
+    b = temp;
+}
+
+// Function to partition the array around a pivot
+inline int partition(std::vector<int>& arr, int low, int high) {
+    int pivot = arr[high]; // Pivot element
+    int i = low - 1; // Index of smaller element
+
+    for (int j = low; j < high; j++) {
+        COUNT_COMPARISON(); // Increment comparison count
+        if (arr[j] <= pivot) {
+            i++;
+            swap(arr[i], arr[j]);
+        }
+    }
+    swap(arr[i + 1], arr[high]);
+    return i + 1;
+}
+
+// Function to randomize the pivot element
+inline int randomizedPartition(std::vector<int>& arr, int low, int high) {
+    srand(time(0)); // Seed for randomness
+    int randomPivot = low + rand() % (high - low + 1);
+    swap(arr[randomPivot], arr[high]); // Move random pivot to end
+    return partition(arr, low, high);
+}
+
+// Function to implement Quick Sort
+inline void randomizedQuickSort(std::vector<int>& arr, int low, int high) {
+    COUNT_RECURSION_DEPTH();
+    if (low < high) {
+        int pivotIndex = randomizedPartition(arr, low, high);
+        randomizedQuickSort(arr, low, pivotIndex - 1); // Sort left of pivot
+        randomizedQuickSort(arr, pivotIndex + 1, high); // Sort right of pivot
+    }
+}
+
+/*
+ * Work-stealing thread pool.
+ * Contains:
+ *  - `queues`: One deque of tasks per worker. The owner pushes and pops at the back,
+ *    idle workers steal from the front, so thieves take the oldest (largest) tasks.
+ *  - `pendingTasks`: Tasks submitted but not yet finished; `wait` returns when it reaches 0.
+ * Tasks submitted from a worker go to that worker's own deque; tasks submitted from
+ * outside the pool are spread round-robin over all deques.
+ */
+class WorkStealingPool {
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // Per-worker task deques
+    std::vector<std::thread> workers;                 // Worker threads
+    std::atomic<long long> pendingTasks;         // Submitted but unfinished tasks
+    std::atomic<bool> stopping;                  // Set by the destructor
+    std::atomic<unsigned> nextQueue;             // Round-robin slot for external submits
+    std::mutex sleepLock;                        // Guards idle workers sleeping
+    std::condition_variable workAvailable;       // Signalled when a task is submitted
+    std::mutex doneLock;                         // Guards waiting for completion
+    std::condition_variable allDone;             // Signalled when pendingTasks drops to 0
+
+    static inline thread_local int workerIndex = -1; // Index of the current worker, -1 outside the pool
+
+    // Pop the newest task from the worker's own deque
+    bool popLocal(int self, std::function<void()>& task) {
+        WorkerQueue& q = *queues[self];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.tasks.empty()) return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    // Steal the oldest task from another worker's deque
+    bool steal(int self, std::function<void()>& task) {
+        int count = queues.size();
+        for (int k = 1; k < count; k++) {
+            WorkerQueue& q = *queues[(self + k) % count];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Main loop of each worker thread
+    void workerLoop(int index) {
+        workerIndex = index;
+        std::function<void()> task;
+        while (!stopping) {
+            if (popLocal(index, task) || steal(index, task)) {
+                task();
+                task = nullptr;
+                if (--pendingTasks == 0) {
+                    std::lock_guard<std::mutex> guard(doneLock);
+                    allDone.notify_all();
+                }
+            } else {
+                std::unique_lock<std::mutex> lk(sleepLock);
+                workAvailable.wait_for(lk, std::chrono::microseconds(200));
+            }
+        }
+    }
+
+public:
+    // Constructor: starts `numThreads` workers
+    WorkStealingPool(int numThreads) : pendingTasks(0), stopping(false), nextQueue(0) {
+        if (numThreads < 1) numThreads = 1;
+        for (int i = 0; i < numThreads; i++) {
+            queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+        }
+        for (int i = 0; i < numThreads; i++) {
+            workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    // Destructor: stops and joins all workers
+    ~WorkStealingPool() {
+        stopping = true;
+        workAvailable.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Function to get the number of worker threads
+    int size() const {
+        return workers.size();
+    }
+
+    // Function to submit a task to the pool
+    void submit(std::function<void()> task) {
+        pendingTasks++;
+        int target = workerIndex;
+        if (target < 0) {
+            target = nextQueue++ % queues.size();
+        }
+        {
+            std::lock_guard<std::mutex> guard(queues[target]->lock);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        workAvailable.notify_one();
+    }
+
+    // Function to block until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lk(doneLock);
+        allDone.wait(lk, [this] { return pendingTasks == 0; });
+    }
+};
+
+// Per-thread random generator for pivot selection (rand() is shared between threads)
+inline std::mt19937& threadRandom() {
+    static std::atomic<unsigned> seedCounter(0);
+    thread_local std::mt19937 rng(time(0) + 7919 * seedCounter++);
+    return rng;
+}
+
+// Function to partition arr[low..high] around a random pivot (Hoare scheme).
+// Returns j such that arr[low..j] <= pivot <= arr[j+1..high], with low <= j < high.
+inline int hoarePartition(std::vector<int>& arr, int low, int high) {
+    int randomPivot = low + threadRandom()() % (high - low + 1);
+    swap(arr[randomPivot], arr[low]); // Move random pivot to the front
+    int pivot = arr[low];
+    int i = low - 1;
+    int j = high + 1;
+
+    while (true) {
+        do {
+            i++;
+            COUNT_COMPARISON();
+        } while (arr[i] < pivot);
+        do {
+            j--;
+            COUNT_COMPARISON();
+        } while (arr[j] > pivot);
+        if (i >= j) {
+            return j;
+        }
+        swap(arr[i], arr[j]);
+    }
+}
+
+// Function to sort arr[low..high] on the calling thread.
+// Recurs on the smaller side and loops on the larger one, so the stack stays O(log n).
+inline void sequentialQuickSort(std::vector<int>& arr, int low, int high) {
+    COUNT_RECURSION_DEPTH();
+    while (low < high) {
+        int split = hoarePartition(arr, low, high);
+        if (split - low < high - split) {
+            sequentialQuickSort(arr, low, split);
+            low = split + 1;
+        } else {
+            sequentialQuickSort(arr, split + 1, high);
+            high = split;
+        }
+    }
+}
+
+// Task body for the parallel sort: splits off subranges as new tasks until the range
+// is at most `grainSize` elements, then finishes it sequentially.
+inline void parallelQuickSortTask(WorkStealingPool& pool, std::vector<int>& arr, int low, int high, int grainSize) {
+    while (high - low + 1 > grainSize) {
+        int split = hoarePartition(arr, low, high);
+        // Hand the larger side to the pool so thieves get big tasks; keep the smaller one
+        if (split - low < high - split) {
+            int l = split + 1, h = high;
+            pool.submit([&pool, &arr, l, h, grainSize] { parallelQuickSortTask(pool, arr, l, h, grainSize); });
+            high = split;
+        } else {
+            int l = low, h = split;
+            pool.submit([&pool, &arr, l, h, grainSize] { parallelQuickSortTask(pool, arr, l, h, grainSize); });
+            low = split + 1;
+        }
+    }
+    sequentialQuickSort(arr, low, high);
+}
+
+/*
+ * Parallel partition of arr[low..high] using every worker of the pool.
+ * Parameters:
+ *  - pool: The pool running the block tasks
+ *  - arr: The array to partition
+ *  - low, high: Range to partition (inclusive)
+ *  - goesLeft: Predicate selecting elements for the left side
+ * Returns:
+ *  - The first index of the right side, so arr[low..mid-1] satisfy `goesLeft`.
+ * Logic:
+ *  - Each block is partitioned in place by its own task.
+ *  - The left-side elements that ended up right of `mid` are then swapped, in parallel,
+ *    with the right-side elements that ended up left of `mid`.
+ */
+inline int parallelPartition(WorkStealingPool& pool, std::vector<int>& arr, int low, int high,
+                      std::function<bool(int)> goesLeft) {
+    int blocks = pool.size();
+    long long total = (long long)high - low + 1;
+    std::vector<int> blockStart(blocks + 1);
+    for (int b = 0; b <= blocks; b++) {
+        blockStart[b] = low + (int)(total * b / blocks);
+    }
+
+    // Step 1: Partition every block independently
+    std::vector<int> leftCount(blocks);
+    for (int b = 0; b < blocks; b++) {
+        pool.submit([&, b] {
+            int* first = arr.data() + blockStart[b];
+            int* last = arr.data() + blockStart[b + 1];
+            leftCount[b] = std::partition(first, last, goesLeft) - first;
+        });
+    }
+    pool.wait();
+
+    int mid = low;
+    for (int b = 0; b < blocks; b++) {
+        mid += leftCount[b];
+    }
+
+    // Step 2: Collect misplaced right-side elements before `mid` and left-side elements after it
+    std::vector<std::pair<int, int>> wrongLeft, wrongRight; // Half-open index intervals
+    for (int b = 0; b < blocks; b++) {
+        int boundary = blockStart[b] + leftCount[b];
+        int s = std::max(boundary, low), e = std::min(blockStart[b + 1], mid);
+        if (s < e) wrongLeft.push_back({s, e});
+        s = std::max(blockStart[b], mid), e = std::min(boundary, high + 1);
+        if (s < e) wrongRight.push_back({s, e});
+    }
+
+    // Step 3: Swap the k-th misplaced element of one list with the k-th of the other
+    long long misplaced = 0;
+    for (const auto& range : wrongLeft) {
+        misplaced += range.second - range.first;
+    }
+    for (int b = 0; b < blocks && misplaced > 0; b++) {
+        long long from = misplaced * b / blocks, to = misplaced * (b + 1) / blocks;
+        if (from == to) continue;
+        pool.submit([&, from, to] {
+            // Locate position `offset` inside an interval list
+            auto locate = [](const std::vector<std::pair<int, int>>& list, long long offset, size_t& idx, int& pos) {
+                idx = 0;
+                while (offset >= list[idx].second - list[idx].first) {
+                    offset -= list[idx].second - list[idx].first;
+                    idx++;
+                }
+                pos = list[idx].first + (int)offset;
+            };
+            size_t li, ri;
+            int lp, rp;
+            locate(wrongLeft, from, li, lp);
+            locate(wrongRight, from, ri, rp);
+            for (long long k = from; k < to; k++) {
+                if (lp == wrongLeft[li].second) lp = wrongLeft[++li].first;
+                if (rp == wrongRight[ri].second) rp = wrongRight[++ri].first;
+                swap(arr[lp++], arr[rp++]);
+            }
+        });
+    }
+    pool.wait();
+    return mid;
+}
+
+/*
+ * Parallel Randomized Quick Sort on a work-stealing pool.
+ * Parameters:
+ *  - arr: The array to sort
+ *  - numThreads: Number of worker threads
+ *  - grainSize: Ranges of at most this many elements are sorted sequentially
+ * Logic:
+ *  - The top levels (until there are about as many ranges as threads) use
+ *    `parallelPartition`, so no single thread has to partition the whole array.
+ *  - The remaining ranges become tasks that split themselves further and are
+ *    balanced between threads by work stealing.
+ */
+inline void parallelRandomizedQuickSort(std::vector<int>& arr, int numThreads, int grainSize) {
+    int n = arr.size();
+    if (n < 2) return;
+    if (grainSize < 1) grainSize = 1;
+
+    WorkStealingPool pool(numThreads);
+    std::vector<std::pair<int, int>> ranges = {{0, n - 1}};
+
+    // Data-parallel top levels
+    while ((int)ranges.size() < pool.size()) {
+        std::vector<std::pair<int, int>> next;
+        bool split = false;
+        for (const auto& range : ranges) {
+            int low = range.first, high = range.second;
+            if (pool.size() == 1 || high - low + 1 <= std::max(grainSize, 1 << 16)) {
+                next.push_back(range);
+                continue;
+            }
+            int pivot = arr[low + threadRandom()() % (high - low + 1)];
+            int mid = parallelPartition(pool, arr, low, high, [pivot](int x) { return x < pivot; });
+            if (mid == low) {
+                // Nothing is smaller than the pivot: peel off all copies of it instead
+                mid = parallelPartition(pool, arr, low, high, [pivot](int x) { return x <= pivot; });
+                if (mid <= high) next.push_back({mid, high});
+            } else {
+                next.push_back({low, mid - 1});
+                next.push_back({mid, high});
+            }
+            split = true;
+        }
+        ranges.swap(next);
+        if (!split) break;
+    }
+
+    // Task-parallel lower levels
+    for (const auto& range : ranges) {
+        int low = range.first, high = range.second;
+        pool.submit([&pool, &arr, low, high, grainSize] { parallelQuickSortTask(pool, arr, low, high, grainSize); });
+    }
+    pool.wait();
+}
+
+/*
+ * Radix sort engine for integral keys.
+ * Keys are mapped to unsigned values whose order matches the key order
+ * (signed keys get their sign bit flipped), then sorted digit by digit.
+ */
+
+// Inputs smaller than this are sorted with a comparison sort by `autoSort`
+const size_t RADIX_SORT_THRESHOLD = 2048;
+
+// Buckets smaller than this are finished with insertion sort in the MSD variant
+const size_t MSD_INSERTION_THRESHOLD = 64;
+
+// Function to map a key to an unsigned value with the same ordering
+template <typename T>
+typename std::make_unsigned<T>::type radixKey(T x) {
+    typedef typename std::make_unsigned<T>::type U;
+    U key = (U)x;
+    if (std::is_signed<T>::value) {
+        key ^= (U)1 << (sizeof(T) * 8 - 1); // Negative keys sort before positive ones
+    }
+    return key;
+}
+
+// Floating-point keys: flip all bits of negatives, only the sign bit of positives
+inline uint32_t radixKey(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits ^ 0x80000000u;
+}
+
+inline uint64_t radixKey(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : bits ^ 0x8000000000000000ull;
+}
+
+/*
+ * LSD (least significant digit first) radix sort.
+ * Parameters:
+ *  - arr: The array to sort
+ *  - keyOf: Returns the arithmetic sort key of an element
+ *  - DigitBits: Bits per digit (8 or 11), a compile-time constant
+ * Logic:
+ *  - One pass over the keys builds the histograms of every digit at once.
+ *  - A digit for which all keys fall into the same bucket needs no scatter pass.
+ *  - Each remaining digit is a stable scatter between `arr` and a buffer of size n.
+ */
+template <int DigitBits, typename T, typename KeyOf>
+void lsdRadixSortBy(std::vector<T>& arr, KeyOf keyOf) {
+    const int keyBits = sizeof(radixKey(keyOf(arr[0]))) * 8;
+    const int digits = (keyBits + DigitBits - 1) / DigitBits;
+    const size_t buckets = (size_t)1 << DigitBits;
+    const size_t mask = buckets - 1;
+    size_t n = arr.size();
+    if (n < 2) return;
+
+    // Step 1: Histograms of all digits in a single pass
+    std::vector<size_t> counts(digits * buckets, 0);
+    for (size_t i = 0; i < n; i++) {
+        auto key = radixKey(keyOf(arr[i]));
+        for (int d = 0; d < digits; d++) {
+            counts[d * buckets + ((key >> (d * DigitBits)) & mask)]++;
+        }
+    }
+
+    // Step 2: Scatter by every digit that actually distinguishes the keys
+    std::vector<T> buffer(n);
+    T* from = arr.data();
+    T* to = buffer.data();
+    for (int d = 0; d < digits; d++) {
+        size_t* count = &counts[d * buckets];
+        int shift = d * DigitBits;
+        if (count[(radixKey(keyOf(from[0])) >> shift) & mask] == n) {
+            continue; // Every key has the same digit here
+        }
+
+        size_t offset = 0;
+        for (size_t b = 0; b < buckets; b++) {
+            size_t c = count[b];
+            count[b] = offset; // Histogram becomes the bucket start positions
+            offset += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            to[count[(radixKey(keyOf(from[i])) >> shift) & mask]++] = std::move(from[i]);
+        }
+        std::swap(from, to);
+    }
+
+    // An odd number of scatter passes leaves the result in the buffer
+    if (from != arr.data()) {
+        arr.swap(buffer);
+    }
+}
+
+// Function to radix sort an array of keys
+template <int DigitBits, typename T>
+void lsdRadixSort(std::vector<T>& arr) {
+    lsdRadixSortBy<DigitBits>(arr, [](const T& x) { return x; });
+}
+
+// Function to sort a small range of keys by insertion
+template <typename T>
+void insertionSort(T* first, T* last) {
+    for (T* i = first + 1; i < last; i++) {
+        T x = *i;
+        T* j = i;
+        while (j > first && x < *(j - 1)) {
+            *j = *(j - 1);
+            j--;
+        }
+        *j = x;
+    }
+}
+
+/*
+ * In-place MSD radix sort (American flag sort) of [first, last) on the byte at `shift`.
+ * Logic:
+ *  - Count the keys per bucket and compute each bucket's [head, tail) region.
+ *  - Walk every bucket's region and swap each misplaced key directly into the
+ *    next free slot of its own bucket (cycle following), so no buffer is needed.
+ *  - Recurse into each bucket on the next lower byte.
+ */
+template <typename T>
+void americanFlagSort(T* first, T* last, int shift) {
+    size_t n = last - first;
+    if (n <= MSD_INSERTION_THRESHOLD) {
+        insertionSort(first, last);
+        return;
+    }
+
+    size_t count[256] = {0};
+    for (T* p = first; p < last; p++) {
+        count[(radixKey(*p) >> shift) & 0xFF]++;
+    }
+
+    // All keys share this byte: go straight to the next one
+    if (count[(radixKey(*first) >> shift) & 0xFF] == n) {
+        if (shift > 0) americanFlagSort(first, last, shift - 8);
+        return;
+    }
+
+    size_t head[256], tail[256];
+    size_t offset = 0;
+    for (int b = 0; b < 256; b++) {
+        head[b] = offset;
+        offset += count[b];
+        tail[b] = offset;
+    }
+
+    for (int b = 0; b < 256; b++) {
+        while (head[b] < tail[b]) {
+            T x = first[head[b]];
+            int digit = (radixKey(x) >> shift) & 0xFF;
+            while (digit != b) {
+                // Place x into its bucket and pick up the key it displaces
+                std::swap(x, first[head[digit]++]);
+                digit = (radixKey(x) >> shift) & 0xFF;
+            }
+            first[head[b]++] = x;
+        }
+    }
+
+    if (shift > 0) {
+        size_t start = 0;
+        for (int b = 0; b < 256; b++) {
+            if (count[b] > 1) {
+                americanFlagSort(first + start, first + start + count[b], shift - 8);
+            }
+            start += count[b];
+        }
+    }
+}
+
+// Function to sort the whole array with the in-place MSD radix sort
+template <typename T>
+void americanFlagSort(std::vector<T>& arr) {
+    if (arr.size() < 2) return;
+    americanFlagSort(arr.data(), arr.data() + arr.size(), (int)(sizeof(T) - 1) * 8);
+}
+
+// Comparison-sort fallback: the in-repo quick sort for int, the standard sort otherwise
+inline void comparisonSort(std::vector<int>& arr) {
+    sequentialQuickSort(arr, 0, (int)arr.size() - 1);
+}
+
+template <typename T>
+void comparisonSort(std::vector<T>& arr) {
+    std::sort(arr.begin(), arr.end());
+}
+
+/*
+ * Sort dispatcher.
+ * Parameters:
+ *  - arr: The array to sort
+ *  - inPlace: Avoid the O(n) buffer of the LSD sort (memory-constrained runs)
+ * Returns:
+ *  - The name of the algorithm that was used.
+ * Logic:
+ *  - Integral keys with at least RADIX_SORT_THRESHOLD elements use radix sort:
+ *    LSD with 11-bit digits for 32-bit keys (3 passes instead of 4), 8-bit digits
+ *    otherwise, or the American flag sort when `inPlace` is set.
+ *  - Small inputs and non-integral keys use a comparison sort.
+ */
+template <typename T>
+const char* autoSort(std::vector<T>& arr, bool inPlace) {
+    if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value) {
+        if (arr.size() >= RADIX_SORT_THRESHOLD) {
+            if (inPlace) {
+                americanFlagSort(arr);
+                return "In-place MSD radix sort (American flag)";
+            }
+            if (sizeof(T) == 4) {
+                lsdRadixSort<11>(arr);
+                return "LSD radix sort (11-bit digits)";
+            }
+            lsdRadixSort<8>(arr);
+            return "LSD radix sort (8-bit digits)";
+        }
+    }
+    comparisonSort(arr);
+    return "Comparison sort";
+}
+
+/*
+ * Generic sort over records.
+ * Works on any random-access range with a comparator on keys and a key projection
+ * (a function returning the sort key of a record), so records are never compared whole.
+ *  - `sortBy`: Sorts the records directly (they are moved on every swap).
+ *  - `tagSort`: Sorts compact (key, index) tags instead, then moves every record once.
+ *  - `genericSort`: Uses `tagSort` for records much larger than a tag, `sortBy` otherwise.
+ * Integer, float and double keys compared with `less` are radix sorted; this is decided at
+ * compile time.
+ */
+
+// Projection returning the record itself
+struct IdentityKey {
+    template <typename T>
+    const T& operator()(const T& x) const {
+        return x;
+    }
+};
+
+/*
+ * True if keys of type Key ordered by Compare can be radix sorted: the types `radixKey` maps,
+ * i.e. integers other than bool, float and double. Other keys (e.g. long double) use quickSortBy.
+ */
+template <typename Key, typename Compare>
+struct IsRadixSortable {
+    static const bool value = ((std::is_integral<Key>::value && !std::is_same<Key, bool>::value) ||
+                               std::is_same<Key, float>::value || std::is_same<Key, double>::value) &&
+                              (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<Key>>::value);
+};
+
+// Key-index pair used by `tagSort`
+template <typename Key, typename Index>
+struct Tag {
+    Key key;
+    Index index;
+};
+
+// Function to sort [first, last) by projected key with quick sort and an insertion sort finish
+template <typename RandomIt, typename Compare, typename Projection>
+void quickSortBy(RandomIt first, RandomIt last, Compare comp, Projection proj) {
+    while (last - first > 16) {
+        // Hoare partition around a random pivot moved to the front
+        auto randomPivot = threadRandom()() % (last - first);
+        std::iter_swap(first, first + randomPivot);
+        auto pivot = proj(*first);
+        RandomIt i = first - 1, j = last;
+        while (true) {
+            do {
+                ++i;
+            } while (comp(proj(*i), pivot));
+            do {
+                --j;
+            } while (comp(pivot, proj(*j)));
+            if (i >= j) break;
+            std::iter_swap(i, j);
+        }
+        // Recur on the smaller side, loop on the larger one
+        if (j + 1 - first < last - (j + 1)) {
+            quickSortBy(first, j + 1, comp, proj);
+            first = j + 1;
+        } else {
+            quickSortBy(j + 1, last, comp, proj);
+            last = j + 1;
+        }
+    }
+    for (RandomIt i = first + 1; i < last; ++i) {
+        auto x = std::move(*i);
+        RandomIt j = i;
+        while (j > first && comp(proj(x), proj(*(j - 1)))) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(x);
+    }
+}
+
+/*
+ * Direct sort of the records in [first, last).
+ * Parameters:
+ *  - first, last: Random-access range of records
+ *  - comp: Strict weak ordering on keys
+ *  - proj: Returns the key of a record
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = IdentityKey>
+void sortBy(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection()) {
+    typedef typename std::iterator_traits<RandomIt>::value_type Record;
+    typedef typename std::decay<decltype(proj(*first))>::type Key;
+
+    if constexpr (IsRadixSortable<Key, Compare>::value) {
+        if ((size_t)(last - first) >= RADIX_SORT_THRESHOLD) {
+            std::vector<Record> records(std::make_move_iterator(first), std::make_move_iterator(last));
+            lsdRadixSortBy<8>(records, proj);
+            std::move(records.begin(), records.end(), first);
+            return;
+        }
+    }
+    quickSortBy(first, last, comp, proj);
+}
+
+/*
+ * Function to reorder records so that position i receives the record at `source[i]`.
+ * Follows each cycle of the permutation once, so every record is moved exactly once
+ * (plus one temporary per cycle). `source` is used to mark finished positions.
+ */
+template <typename RandomIt, typename Index>
+void applyPermutation(RandomIt first, std::vector<Index>& source) {
+    for (size_t start = 0; start < source.size(); start++) {
+        if (source[start] == start) continue;
+        auto carried = std::move(first[start]);
+        size_t pos = start;
+        while (source[pos] != start) {
+            size_t next = source[pos];
+            first[pos] = std::move(first[next]);
+            source[pos] = pos;
+            pos = next;
+        }
+        first[pos] = std::move(carried);
+        source[pos] = pos;
+    }
+}
+
+// Key-index sort with a given index width
+template <typename Index, typename RandomIt, typename Compare, typename Projection>
+void tagSortImpl(RandomIt first, RandomIt last, Compare comp, Projection proj) {
+    typedef typename std::decay<decltype(proj(*first))>::type Key;
+    size_t n = last - first;
+
+    std::vector<Tag<Key, Index>> tags(n);
+    for (size_t i = 0; i < n; i++) {
+        tags[i].key = proj(first[i]);
+        tags[i].index = i;
+    }
+
+    // Radix sort and the index tie-break both keep equal keys in input order
+    if constexpr (IsRadixSortable<Key, Compare>::value) {
+        lsdRadixSortBy<8>(tags, [](const Tag<Key, Index>& tag) { return tag.key; });
+    } else {
+        quickSortBy(tags.begin(), tags.end(), [&comp](const Tag<Key, Index>& a, const Tag<Key, Index>& b) {
+            if (comp(a.key, b.key)) return true;
+            if (comp(b.key, a.key)) return false;
+            return a.index < b.index;
+        }, [](const Tag<Key, Index>& tag) -> const Tag<Key, Index>& { return tag; });
+    }
+
+    std::vector<Index> source(n);
+    for (size_t i = 0; i < n; i++) {
+        source[i] = tags[i].index;
+    }
+    tags.clear();
+    tags.shrink_to_fit();
+    applyPermutation(first, source);
+}
+
+/*
+ * Key-index (tag) sort of the records in [first, last).
+ * Sorts (key, index) pairs, using 32-bit indices when they suffice, and then permutes
+ * the records in place. The result is stable.
+ */
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = IdentityKey>
+void tagSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection()) {
+    if (last - first < 2) return;
+    if ((unsigned long long)(last - first) <= UINT32_MAX) {
+        tagSortImpl<uint32_t>(first, last, comp, proj);
+    } else {
+        tagSortImpl<uint64_t>(first, last, comp, proj);
+    }
+}
+
+// Function to sort records, choosing between moving records and sorting tags by record size
+template <typename RandomIt, typename Compare = std::less<>, typename Projection = IdentityKey>
+void genericSort(RandomIt first, RandomIt last, Compare comp = Compare(), Projection proj = Projection()) {
+    typedef typename std::iterator_traits<RandomIt>::value_type Record;
+    typedef typename std::decay<decltype(proj(*first))>::type Key;
+
+    if (sizeof(Record) > 2 * sizeof(Tag<Key, uint32_t>)) {
+        tagSort(first, last, comp, proj);
+    } else {
+        sortBy(first, last, comp, proj);
+    }
+}
+
+/*
+ * External merge sort for binary files of `int` that do not fit in memory.
+ * Phase 1 cuts the input into runs that fit the memory budget, sorts each run with
+ * `autoSort` and writes it to the temp directory. Phase 2 merges the runs with a
+ * loser tree; every run and the output are double-buffered and the inactive buffer is
+ * read or written by a background task, so disk I/O overlaps with merging.
+ */
+
+// Smallest per-run merge buffer; more runs than the budget allows at this size are merged in several passes
+const size_t MIN_MERGE_BUFFER_ELEMENTS = 1 << 16;
+
+// Function to open a file, throwing if that fails
+inline FILE* openFile(const std::string& path, const char* mode) {
+    FILE* file = fopen(path.c_str(), mode);
+    if (file == nullptr) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    return file;
+}
+
+// Deleter that closes the file of a `FileHandle`
+struct FileCloser {
+    void operator()(FILE* file) const { fclose(file); }
+};
+
+// Owning file handle, closed when it goes out of scope (e.g. while an exception propagates)
+typedef std::unique_ptr<FILE, FileCloser> FileHandle;
+
+/*
+ * Temporary files of one sort.
+ * Every path is registered before the file is created, and the destructor removes all of
+ * them, so runs, merged runs and a half-written merge output never outlive the sort.
+ */
+class TempFiles {
+private:
+    std::string prefix;
+    int counter;
+    std::vector<std::string> paths;
+
+public:
+    TempFiles(const std::string& _prefix) : prefix(_prefix), counter(0) {}
+
+    ~TempFiles() {
+        for (const std::string& path : paths) remove(path.c_str());
+    }
+
+    TempFiles(const TempFiles&) = delete;
+    TempFiles& operator=(const TempFiles&) = delete;
+
+    // Function to reserve a new temporary path
+    std::string create() {
+        paths.push_back(prefix + "_" + std::to_string(counter++) + ".run");
+        return paths.back();
+    }
+};
+
+/*
+ * Sequential reader of one sorted run with double buffering.
+ * While `next` consumes the front buffer, the back buffer is filled asynchronously.
+ */
+class RunReader {
+private:
+    FILE* file;
+    long long remaining;        // Elements not yet requested from the file
+    std::vector<int> front, back;    // Buffer being consumed / buffer being filled
+    size_t pos, len;            // Read position and fill level of `front`
+    std::future<size_t> pendingRead; // Fill of `back` in progress
+
+    // Start filling the back buffer in the background
+    void startRead() {
+        size_t count = (size_t)std::min<long long>(remaining, back.size());
+        remaining -= count;
+        pendingRead = std::async(std::launch::async, [this, count] {
+            if (fread(back.data(), sizeof(int), count, file) != count) {
+                throw std::runtime_error("short read from run file");
+            }
+            return count;
+        });
+    }
+
+public:
+    // Constructor: `elements` is the run length, `bufferElements` the size of each buffer
+    RunReader(const std::string& path, long long elements, size_t bufferElements)
+        : file(openFile(path, "rb")), remaining(elements), front(bufferElements), back(bufferElements), pos(0), len(0) {
+        startRead();
+    }
+
+    ~RunReader() {
+        if (pendingRead.valid()) pendingRead.wait();
+        fclose(file);
+    }
+
+    // Function to fetch the next key; returns false once the run is exhausted
+    bool next(int& x) {
+        if (pos == len) {
+            if (!pendingRead.valid()) return false;
+            len = pendingRead.get();
+            front.swap(back);
+            pos = 0;
+            if (remaining > 0) startRead();
+            if (len == 0) return false;
+        }
+        x = front[pos++];
+        return true;
+    }
+};
+
+/*
+ * Sequential writer with double buffering.
+ * A full buffer is handed to a background write while the other one is filled.
+ */
+class RunWriter {
+private:
+    FILE* file;
+    std::vector<int> front, back;
+    size_t len;
+    std::future<void> pendingWrite;
+
+    void flushFront() {
+        if (pendingWrite.valid()) pendingWrite.get();
+        front.swap(back);
+        size_t count = len;
+        len = 0;
+        pendingWrite = std::async(std::launch::async, [this, count] {
+            if (fwrite(back.data(), sizeof(int), count, file) != count) {
+                throw std::runtime_error("short write to output file");
+            }
+        });
+    }
+
+public:
+    RunWriter(const std::string& path, size_t bufferElements)
+        : file(openFile(path, "wb")), front(bufferElements), back(bufferElements), len(0) {}
+
+    ~RunWriter() {
+        if (pendingWrite.valid()) pendingWrite.wait();
+        fclose(file);
+    }
+
+    // Function to append one key
+    void push(int x) {
+        front[len++] = x;
+        if (len == front.size()) flushFront();
+    }
+
+    // Function to write out everything buffered; must be called before destruction
+    void finish() {
+        if (len > 0) flushFront();
+        if (pendingWrite.valid()) pendingWrite.get();
+        if (fflush(file) != 0) {
+            throw std::runtime_error("cannot flush output file");
+        }
+    }
+};
+
+/*
+ * Loser tree for k-way merging.
+ * Contains:
+ *  - `tree[0]`: Index of the run holding the current smallest key.
+ *  - `tree[1..k-1]`: The loser of the match played at each internal node.
+ * Replacing the winner's key and replaying its path costs O(log k) comparisons.
+ */
+class LoserTree {
+private:
+    int k;
+    std::vector<int> tree;
+    std::vector<int> keys;
+    std::vector<bool> exhausted;
+
+    // True if run a's key should be output before run b's (index k is a -infinity sentinel)
+    bool beats(int a, int b) const {
+        if (a == k) return true;
+        if (b == k) return false;
+        if (exhausted[a]) return false;
+        if (exhausted[b]) return true;
+        return keys[a] < keys[b];
+    }
+
+    // Replay the matches on the path from leaf s to the root
+    void adjust(int s) {
+        for (int t = (s + k) / 2; t > 0; t /= 2) {
+            if (beats(tree[t], s)) {
+                std::swap(s, tree[t]); // Not quicksort::swap, which would count the swap
+            }
+        }
+        tree[0] = s;
+    }
+
+public:
+    LoserTree(int _k) : k(_k), tree(_k, _k), keys(_k), exhausted(_k, true) {}
+
+    // Function to set the first key of every run and build the tree
+    void build(const std::vector<int>& firstKeys, const std::vector<bool>& empty) {
+        keys = firstKeys;
+        exhausted = empty;
+        for (int s = k - 1; s >= 0; s--) {
+            adjust(s);
+        }
+    }
+
+    int winner() const { return tree[0]; }
+    bool done() const { return exhausted[tree[0]]; }
+    int winnerKey() const { return keys[tree[0]]; }
+
+    // Function to replace the winner's key (or mark its run exhausted) and replay
+    void replaceWinner(bool hasKey, int key) {
+        int w = tree[0];
+        keys[w] = key;
+        exhausted[w] = !hasKey;
+        adjust(w);
+    }
+};
+
+// A sorted run stored on disk
+struct RunFile {
+    std::string path;
+    long long elements;
+};
+
+// Function to merge `runs` into `outPath` through a loser tree using `bufferElements` per buffer
+inline void mergeRuns(const std::vector<RunFile>& runs, const std::string& outPath, size_t bufferElements) {
+    int k = runs.size();
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<int> firstKeys(k);
+    std::vector<bool> empty(k);
+    for (int r = 0; r < k; r++) {
+        readers.push_back(std::unique_ptr<RunReader>(new RunReader(runs[r].path, runs[r].elements, bufferElements)));
+        int x = 0;
+        empty[r] = !readers[r]->next(x);
+        firstKeys[r] = x;
+    }
+
+    RunWriter writer(outPath, bufferElements);
+    if (k > 0) {
+        LoserTree tree(k);
+        tree.build(firstKeys, empty);
+        while (!tree.done()) {
+            writer.push(tree.winnerKey());
+            int x = 0;
+            bool hasKey = readers[tree.winner()]->next(x);
+            tree.replaceWinner(hasKey, x);
+        }
+    }
+    writer.finish();
+}
+
+/*
+ * External merge sort.
+ * Parameters:
+ *  - inPath: Binary input file of native-endian `int` values
+ *  - outPath: Binary output file
+ *  - memoryBytes: Memory budget for run buffers
+ *  - tempDir: Directory for the temporary run files
+ * Throws runtime_error if a file cannot be read or written, or if the input size is not a
+ * multiple of sizeof(int); the temporary files are removed either way.
+ */
+inline void externalSort(const std::string& inPath, const std::string& outPath, size_t memoryBytes, const std::string& tempDir) {
+    size_t budget = std::max<size_t>(memoryBytes / sizeof(int), 4 * MIN_MERGE_BUFFER_ELEMENTS);
+    TempFiles temp(tempDir + "/extsort_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::vector<RunFile> runs;
+
+    // Phase 1: Run formation (half the budget for the run, half for the radix sort buffer)
+    {
+        FileHandle in(openFile(inPath, "rb"));
+        std::vector<int> run(budget / 2);
+        while (true) {
+            // Read bytes rather than ints, so that a trailing partial int is noticed
+            size_t bytes = fread(run.data(), 1, run.size() * sizeof(int), in.get());
+            if (ferror(in.get())) {
+                throw std::runtime_error("cannot read " + inPath);
+            }
+            if (bytes % sizeof(int) != 0) {
+                throw std::runtime_error(inPath + " does not hold a whole number of ints");
+            }
+            size_t count = bytes / sizeof(int);
+            if (count == 0) break;
+            run.resize(count);
+            autoSort(run, false);
+
+            RunFile file = {temp.create(), (long long)count};
+            FileHandle out(openFile(file.path, "wb"));
+            bool ok = fwrite(run.data(), sizeof(int), count, out.get()) == count;
+            ok = fclose(out.release()) == 0 && ok;
+            if (!ok) throw std::runtime_error("cannot write " + file.path);
+            runs.push_back(file);
+            run.resize(budget / 2);
+        }
+    }
+
+    // Phase 2: Merge passes; two buffers per input run plus two for the output
+    size_t maxFanIn = std::max<size_t>(2, budget / (2 * MIN_MERGE_BUFFER_ELEMENTS) - 1);
+    while (runs.size() > maxFanIn) {
+        std::vector<RunFile> merged;
+        for (size_t first = 0; first < runs.size(); first += maxFanIn) {
+            std::vector<RunFile> group(runs.begin() + first, runs.begin() + std::min(runs.size(), first + maxFanIn));
+            RunFile file = {temp.create(), 0};
+            for (const RunFile& r : group) file.elements += r.elements;
+            mergeRuns(group, file.path, budget / (2 * (group.size() + 1)));
+            for (const RunFile& r : group) remove(r.path.c_str());
+            merged.push_back(file);
+        }
+        runs.swap(merged);
+    }
+    mergeRuns(runs, outPath, budget / (2 * (runs.size() + 1)));
+}
+
+} // namespace quicksort
+
+#endif
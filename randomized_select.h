@@ -0,0 +1,107 @@
+#ifndef RANDOMIZED_SELECT_H
+#define RANDOMIZED_SELECT_H
+
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include "sort_counters.h"
+
+/*
+ * Selection of the ith smallest element with Randomized Select.
+ * Contains:
+ *  - `swap`, `partition`, `randomizedPartition`: Lomuto partitioning around a random pivot.
+ *  - `randomizedSelect`: Recursion into the one side that holds the wanted rank.
+ * Comparisons, swaps and recursion depth are counted through sort_counters.h.
+ */
+namespace selection {
+
+/*
+ * Function to swap two elements.
+ * Parameters:
+ *  - a: First element
+ *  - b: Second element
+ * Swaps the values of the two elements.
+ */
+inline void swap(int& a, int& b) {
+    COUNT_SWAP();
+    int temp = a;
+    a = b;
+    b = temp;
+}
+
+/*
+ * Partition function for dividing the array around a pivot element.
+ * Parameters:
+ *  - arr: The array to partition
+ *  - low: Starting index
+ *  - high: Ending index
+ * Returns:
+ *  - The index of the pivot element after partitioning.
+ */
+inline int partition(std::vector<int>& arr, int low, int high) {
+    int pivot = arr[high]; // Choose the last element as pivot
+    int i = low - 1; // Pointer for smaller elements
+
+    // Traverse and place elements smaller than pivot to its left
+    for (int j = low; j < high; j++) {
+        COUNT_COMPARISON();
+        if (arr[j] <= pivot) {
+            i++;
+            swap(arr[i], arr[j]);
+        }
+    }
+    swap(arr[i + 1], arr[high]); // Place pivot in correct position
+    return i + 1; // Return pivot index
+}
+
+/*
+ * Randomized partition function.
+ * Randomly selects a pivot and partitions the array around it.
+ * Parameters:
+ *  - arr: The array to partition
+ *  - low: Starting index
+ *  - high: Ending index
+ * Returns:
+ *  - The index of the pivot element after partitioning.
+ */
+inline int randomizedPartition(std::vector<int>& arr, int low, int high) {
+    srand(time(0)); // Seed for randomness
+    int randomPivot = low + rand() % (high - low + 1); // Random pivot index
+    swap(arr[randomPivot], arr[high]); // Move random pivot to end
+    return partition(arr, low, high);
+}
+
+/*
+ * Randomized Select function to find the ith smallest element.
+ * Parameters:
+ *  - arr: The array
+ *  - low: Starting index
+ *  - high: Ending index
+ *  - i: The rank (1-based index) of the smallest element to find
+ * Returns:
+ *  - The ith smallest element in the array.
+ * Logic:
+ *  - Randomly partition the array and determine the position of the pivot.
+ *  - Recursively search the left or right subarray based on the position of the pivot.
+ */
+inline int randomizedSelect(std::vector<int>& arr, int low, int high, int i) {
+    COUNT_RECURSION_DEPTH();
+    if (low == high) {
+        return arr[low]; // Only one element left
+    }
+
+    int pivotIndex = randomizedPartition(arr, low, high); // Partition around random pivot
+    int k = pivotIndex - low + 1; // Position of pivot in sorted array
+
+    if (i == k) {
+        return arr[pivotIndex]; // The pivot is the ith smallest element
+    } else if (i < k) {
+        return randomizedSelect(arr, low, pivotIndex - 1, i); // Search left subarray
+    } else {
+        return randomizedSelect(arr, pivotIndex + 1, high, i - k); // Search right subarray
+    }
+}
+
+} // namespace selection
+
+#endif
@@ -1,81 +1,151 @@
 #include <iostream>
 #include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include "kmp.h"
+#include "aho_corasick.h"
+#include "streaming_kmp.h"
+#include "kmp_prefilter.h"
+#include "approximate_match.h"
+#include "fast_io.h"
 using namespace std;
+using namespace fast_io;
+using namespace kmp;
 
 /*
- * Function to compute the Longest Prefix Suffix (LPS) array.
- * The LPS array helps avoid redundant comparisons in the KMP algorithm.
+ * Function to print the starting indices of all occurrences of the pattern in the text.
+ * Uses the SIMD prefilter (kmp_prefilter.h), which falls back to Shift-Or or the KMP DFA
+ * (kmp_automaton.h) when the CPU has no AVX2 or when candidate positions are dense.
  */
-void computeLPSArray(const string& pattern, vector<int>& lps) {
-    int length = 0; // Length of the previous longest prefix suffix
-    int i = 1;
-    lps[0] = 0; // lps[0] is always 0
+void KMPsearch(FastWriter& out, const string& text, const string& pattern) {
+    vector<size_t> matches = PrefilteredKMP(pattern).findAll(text);
+    out << "Pattern found at indices: ";
+    for (size_t index : matches) {
+        out << index << " ";
+    }
+    out << '\n';
+}
 
-    // Loop through the pattern to fill the LPS array
-    while (i < pattern.size()) {
-        if (pattern[i] == pattern[length]) {
-            length++;
-            lps[i] = length;
-            i++;
-        } else {
-            if (length != 0) {
-                length = lps[length - 1]; // Backtrack
-            } else {
-                lps[i] = 0;
-                i++;
-            }
+/*
+ * Function to search for several patterns in one pass over the text with Aho-Corasick
+ * (aho_corasick.h), and print the starting indices of each pattern.
+ */
+void multiPatternSearch(FastWriter& out, const string& text, const vector<string>& patterns) {
+    AhoCorasick matcher(patterns);
+    vector<vector<size_t>> found(patterns.size());
+    matcher.search(text.data(), text.size(), [&](size_t position, int pattern) {
+        found[pattern].push_back(position);
+    });
+    for (size_t p = 0; p < patterns.size(); p++) {
+        out << "Pattern \"" << patterns[p] << "\" found at indices: ";
+        for (size_t index : found[p]) {
+            out << index << " ";
         }
+        out << '\n';
     }
 }
 
 /*
- * Function to implement the KMP algorithm for pattern searching.
- * It returns the starting indices of all occurrences of the pattern in the text.
+ * Function to search a file, or standard input for "-", without loading it into memory
+ * (streaming_kmp.h), and print the absolute offsets of all occurrences of the pattern.
  */
-void KMPsearch(const string& text, const string& pattern) {
-    int n = text.size();
-    int m = pattern.size();
+void streamSearch(FastWriter& out, const string& path, const string& pattern) {
+    StreamingKMP matcher(pattern);
+    long long count = 0;
+    uint64_t bytes = searchFile(path, matcher, [&](uint64_t offset) {
+        // Offsets are printed as they are found, since a large file can have any number of them
+        if (count++ == 0) out << "Pattern found at offsets: ";
+        out << offset << " ";
+    });
+    if (count > 0) out << '\n';
+    out << count << " matches in " << bytes << " bytes\n";
+}
 
-    // Step 1: Compute the LPS array
-    vector<int> lps(m);
-    computeLPSArray(pattern, lps);
+/*
+ * Function to print the approximate occurrences of the pattern with at most k differences
+ * (approximate_match.h): by Hamming distance the starting index of each occurrence, by
+ * edit distance the index where each matching substring ends.
+ */
+void approximateSearch(FastWriter& out, const string& text, const string& pattern, int k, bool editDistance) {
+    if (editDistance) {
+        EditDistanceMatcher matcher(pattern, k);
+        matcher.feed(text.data(), text.size(), [&](uint64_t end, int distance) {
+            out << "Match ending at index " << end << " with distance " << distance << '\n';
+        });
+    } else {
+        HammingMatcher matcher(pattern, k);
+        matcher.feed(text.data(), text.size(), [&](uint64_t start, int distance) {
+            out << "Match at index " << start << " with " << distance << " mismatches\n";
+        });
+    }
+}
 
-    int i = 0; // Index for text
-    int j = 0; // Index for pattern
+int main(int argc, char* argv[]) {
+    try {
+        // With arguments `<pattern> <file>...` each file ("-" for standard input) is searched directly
+        if (argc >= 3 && string(argv[1]) != "--batch") {
+            FastWriter out;
+            for (int a = 2; a < argc; a++) {
+                out << argv[a] << ": ";
+                streamSearch(out, argv[a], argv[1]);
+            }
+            out.flush();
+            return 0;
+        }
+
+        DriverOptions options = parseDriverOptions(argc, argv);
+        FastReader in(options.input);
+        FastWriter out(!options.batch);
 
-    cout << "Pattern found at indices: ";
-    while (i < n) {
-        if (pattern[j] == text[i]) {
-            i++;
-            j++;
+        out.prompt("1. Search one pattern (KMP)\n2. Search several patterns (Aho-Corasick)\n"
+                   "3. Search a file (streaming KMP)\n4. Approximate search (Hamming or edit distance)\n"
+                   "Enter your choice: ");
+        int choice = stoi(in.nextLine());
+        if (choice < 1 || choice > 4) {
+            throw invalid_argument("Choice must be between 1 and 4");
         }
+        if (choice == 3) {
+            out.prompt("Enter the file path: ");
+            string path = in.nextLine();
+            out.prompt("Enter the pattern to search: ");
+            string pattern = in.nextLine();
+            streamSearch(out, path, pattern);
+            out.flush();
+            return 0;
+        }
+
+        // Input text and pattern(s) from the user
+        out.prompt("Enter the text: ");
+        string text = in.nextLine();
+        if (choice == 4) {
+            out.prompt("Enter the pattern to search: ");
+            string pattern = in.nextLine();
+            out.prompt("Enter the maximum number of differences k: ");
+            int k = stoi(in.nextLine());
+            out.prompt("Enter 1 for Hamming distance (mismatches) or 2 for edit distance: ");
+            approximateSearch(out, text, pattern, k, stoi(in.nextLine()) == 2);
+        } else if (choice == 1) {
+            out.prompt("Enter the pattern to search: ");
+            string pattern = in.nextLine();
 
-        if (j == m) {
-            // Pattern found, print the starting index
-            cout << i - j << " ";
-            j = lps[j - 1];
-        } else if (i < n && pattern[j] != text[i]) {
-            if (j != 0) {
-                j = lps[j - 1]; // Use LPS to skip unnecessary comparisons
-            } else {
-                i++;
+            // Call the KMP search function
+            KMPsearch(out, text, pattern);
+        } else {
+            out.prompt("Enter the number of patterns: ");
+            int count = stoi(in.nextLine());
+            vector<string> patterns(max(count, 0));
+            for (int p = 0; p < count; p++) {
+                out.prompt("Enter pattern " + to_string(p + 1) + ": ");
+                patterns[p] = in.nextLine();
             }
+            multiPatternSearch(out, text, patterns);
         }
+        out.flush();
+    } catch (const exception& e) {
+        cout << "Error: " << e.what() << endl;
+        return 1;
     }
-    cout << endl;
-}
-
-int main() {
-    string text, pattern;
-
-    // Input text and pattern from the user
-    cout << "Enter the text: ";
-    getline(cin, text);
-    cout << "Enter the pattern to search: ";
-    getline(cin, pattern);
-
-    // Call the KMP search function
-    KMPsearch(text, pattern);
 
     return 0;
 }
@@ -85,35 +155,77 @@ int main() {
  * Purpose:
  *  - Efficiently find all occurrences of a pattern in a given text.
  *  - Uses the LPS array to avoid redundant comparisons by "jumping" over unnecessary checks.
+ *  - Option 1 skips most of the text with a SIMD prefilter (kmp_prefilter.h) before KMP.
+ *  - Option 2 finds several patterns in a single pass with Aho-Corasick (aho_corasick.h).
+ *  - Option 3 searches a file of any size in chunks (streaming_kmp.h).
+ *  - Option 4 finds approximate occurrences within k mismatches or edits (approximate_match.h).
  *
  * Key Components:
- *  1. LPS Array:
+ *  1. LPS Array (kmp.h):
  *      * LPS (Longest Prefix Suffix) stores the length of the longest prefix
  *        which is also a suffix for the pattern up to each position.
  *  2. Search Algorithm:
  *      * Compares characters of the pattern with the text.
  *      * When a mismatch occurs, uses the LPS array to determine how much to backtrack.
+ *  3. Aho-Corasick Automaton:
+ *      * The patterns form a trie; each state gets a failure link to the longest proper
+ *        suffix of its string that is also in the trie, just as lps[i] points to the longest
+ *        proper prefix that is also a suffix.
+ *      * Failure moves are resolved while building, so the search is one table lookup per
+ *        text character, independent of how many patterns there are.
+ *  4. SIMD Prefilter:
+ *      * Two rare bytes of the pattern are compared with 32 or 64 text positions at once
+ *        (AVX2/AVX-512); only positions where both match are compared in full.
+ *      * If such candidates are dense, the search continues with one of the engines below,
+ *        so the O(n + m) bound still holds.
+ *  5. Branch-Free Engines (kmp_automaton.h):
+ *      * The LPS array compiled into a full DFA: one table lookup per text character, since
+ *        every fallback of the search loop is precomputed for every (state, character).
+ *      * Shift-Or keeps one bit per pattern position in a 64-bit word; it is used for
+ *        patterns of up to 64 characters, the DFA up to 254, and the KMP loop beyond.
+ *  6. Approximate Search (approximate_match.h):
+ *      * Hamming distance: Bitap keeps, for every d <= k, one bit per pattern prefix that
+ *        matches the end of the text with at most d mismatches.
+ *      * Edit distance: Myers' algorithm keeps a column of the edit-distance table as bit
+ *        vectors of +1/-1 differences and updates all rows with a few word operations.
+ *      * Patterns longer than 64 characters use several words per bit vector.
+ *  7. Streaming Search:
+ *      * The matcher keeps the LPS array and the number of characters matched (j) between
+ *        chunks, so occurrences spanning two chunks are found and offsets stay absolute.
+ *      * Regular files are memory-mapped one window at a time; pipes are read into two
+ *        buffers, one filled by a reader thread while the other is searched.
  *
  * Input:
- *  - `text`: The main string in which to search for the pattern.
- *  - `pattern`: The substring to search for.
+ *  - `choice`: 1 to search one pattern with KMP, 2 to search several with Aho-Corasick,
+ *    3 to search a file, 4 for an approximate search (then k and the distance).
+ *  - `text`: The main string in which to search for the pattern (option 3: the file path).
+ *  - `pattern`: The substring to search for (option 2: the number of patterns, then each one).
+ *  - Alternatively, the command line `<pattern> <file>...` searches the files without any
+ *    prompts; `-` stands for standard input, e.g. `tail -f log | ./kmp ERROR -`.
+ *  - With `--batch [file]` the menu answers are read one per line, without prompts, from the
+ *    file (or from standard input).
  *
  * Output:
- *  - Prints the starting indices of all occurrences of the pattern in the text.
+ *  - Prints the starting indices of all occurrences of the pattern (of each pattern) in the text.
  *
  * Complexity:
  *  - Time Complexity:
  *     * LPS Array Construction: O(m), where m is the length of the pattern.
  *     * Search Operation: O(n), where n is the length of the text.
  *     * Total: O(n + m).
- *  - Space Complexity: O(m) for the LPS array.
+ *     * Aho-Corasick: O(M * s) to build, where M is the total pattern length and s the number
+ *       of distinct pattern characters; O(n + z) to search, where z is the number of matches.
+ *     * Approximate search: O(n * k * m / 64) for Hamming, O(n * m / 64) for edit distance.
+ *  - Space Complexity: O(m) for the LPS array; O(M * s) for the Aho-Corasick table. The
+ *    streaming search needs O(m) plus its fixed-size buffers, whatever the size of the file.
  *
  * Example:
  *  - Input:
+ *      Enter your choice: 1
  *      Enter the text: ababcabcabababd
  *      Enter the pattern to search: abab
  *  - Output:
- *      Pattern found at indices: 0 7
+ *      Pattern found at indices: 0 8 10
  *
  * How It Works:
  *  - LPS Array for "abab": [0, 0, 1, 2]
@@ -0,0 +1,145 @@
+#ifndef SORT_COUNTERS_H
+#define SORT_COUNTERS_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+/*
+ * Operation counters for the sorting and selection programs.
+ * Contains:
+ *  - `COUNT_COMPARISON()`: Counts one key comparison.
+ *  - `COUNT_SWAP()`: Counts one element swap.
+ *  - `COUNT_RECURSION_DEPTH()`: Placed at the top of a recursive function; tracks the
+ *    current and maximum recursion depth until the enclosing scope ends.
+ * Counts are 64-bit and kept per thread, so counting never contends between threads;
+ * `readCounters` adds up all threads. Compile with -DNO_SORT_COUNTERS to remove every
+ * counter from the generated code.
+ */
+namespace sort_counters {
+
+// Totals returned by `readCounters`
+struct OperationCounts {
+    unsigned long long comparisons;
+    unsigned long long swaps;
+    unsigned long long maxDepth;
+};
+
+#ifdef NO_SORT_COUNTERS
+
+#define COUNT_COMPARISON() ((void)0)
+#define COUNT_SWAP() ((void)0)
+#define COUNT_RECURSION_DEPTH() ((void)0)
+
+inline void resetCounters() {}
+
+inline OperationCounts readCounters() {
+    return OperationCounts{0, 0, 0};
+}
+
+#else
+
+/*
+ * Counters of one thread.
+ * Only the owning thread writes them; relaxed atomics let `readCounters` read them from
+ * another thread without a data race and without lock-prefixed increments.
+ */
+struct ThreadCounters {
+    std::atomic<unsigned long long> comparisons{0};
+    std::atomic<unsigned long long> swaps{0};
+    std::atomic<unsigned long long> maxDepth{0};
+    unsigned long long depth = 0;
+
+    ThreadCounters();
+    ~ThreadCounters();
+};
+
+// Registry of live threads' counters plus the totals of threads that have exited
+struct CounterRegistry {
+    std::mutex lock;
+    std::vector<ThreadCounters*> threads;
+    OperationCounts retired = {0, 0, 0};
+};
+
+inline CounterRegistry& counterRegistry() {
+    static CounterRegistry registry;
+    return registry;
+}
+
+inline ThreadCounters::ThreadCounters() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    registry.threads.push_back(this);
+}
+
+inline ThreadCounters::~ThreadCounters() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    registry.retired.comparisons += comparisons.load(std::memory_order_relaxed);
+    registry.retired.swaps += swaps.load(std::memory_order_relaxed);
+    registry.retired.maxDepth = std::max(registry.retired.maxDepth, maxDepth.load(std::memory_order_relaxed));
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+inline ThreadCounters& threadCounters() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+// Increment a counter owned by the calling thread
+inline void bumpCounter(std::atomic<unsigned long long>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Tracks recursion depth for the lifetime of one call
+struct DepthGuard {
+    ThreadCounters& counters;
+
+    DepthGuard() : counters(threadCounters()) {
+        counters.depth++;
+        if (counters.depth > counters.maxDepth.load(std::memory_order_relaxed)) {
+            counters.maxDepth.store(counters.depth, std::memory_order_relaxed);
+        }
+    }
+
+    ~DepthGuard() {
+        counters.depth--;
+    }
+};
+
+// The macros expand inside other namespaces, so they name the counters fully
+#define COUNT_COMPARISON() ::sort_counters::bumpCounter(::sort_counters::threadCounters().comparisons)
+#define COUNT_SWAP() ::sort_counters::bumpCounter(::sort_counters::threadCounters().swaps)
+#define COUNT_RECURSION_DEPTH() ::sort_counters::DepthGuard recursionDepthGuard
+
+// Function to zero every counter; call only while no thread is sorting
+inline void resetCounters() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    registry.retired = OperationCounts{0, 0, 0};
+    for (ThreadCounters* counters : registry.threads) {
+        counters->comparisons.store(0, std::memory_order_relaxed);
+        counters->swaps.store(0, std::memory_order_relaxed);
+        counters->maxDepth.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Function to add up the counters of all threads
+inline OperationCounts readCounters() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    OperationCounts total = registry.retired;
+    for (ThreadCounters* counters : registry.threads) {
+        total.comparisons += counters->comparisons.load(std::memory_order_relaxed);
+        total.swaps += counters->swaps.load(std::memory_order_relaxed);
+        total.maxDepth = std::max(total.maxDepth, counters->maxDepth.load(std::memory_order_relaxed));
+    }
+    return total;
+}
+
+#endif
+
+} // namespace sort_counters
+
+#endif
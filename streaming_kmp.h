@@ -0,0 +1,228 @@
+#ifndef STREAMING_KMP_H
+#define STREAMING_KMP_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "kmp.h"
+
+/*
+ * Streaming KMP search over text of any length.
+ * Contains:
+ *  - `StreamingKMP`: The KMP matcher as an object. It keeps the LPS array and the number of
+ *    pattern characters matched so far (`j` of KMPsearch) between calls, so the text can be
+ *    given in chunks of any size and matches spanning chunk boundaries are still found.
+ *    Memory is O(m) however long the text is.
+ *  - `searchFile`: Feeds a whole file or pipe to a matcher (StreamingKMP or any other class
+ *    with the same `feed` and `position` functions). Regular files are memory-mapped one
+ *    window at a time; pipes, terminals and other streams are read with two buffers, one
+ *    filled by a reader thread while the other is being searched.
+ * Match positions are absolute offsets from the start of the stream.
+ */
+namespace kmp {
+
+// Function to get the LPS array of a pattern as a vector (computed by `computeLPSArray` in kmp.h)
+inline std::vector<int> buildLPS(const std::string& pattern) {
+    std::vector<int> lps(pattern.size(), 0);
+    if (!pattern.empty()) {
+        computeLPSArray(pattern, lps);
+    }
+    return lps;
+}
+
+class StreamingKMP {
+private:
+    std::string pattern;
+    std::vector<int> lps;
+    int matched;       // Number of pattern characters matched at the end of the text so far
+    uint64_t consumed; // Number of text bytes fed so far
+
+public:
+    // Constructor: computes the LPS array; throws invalid_argument for an empty pattern
+    explicit StreamingKMP(const std::string& _pattern) : pattern(_pattern), lps(buildLPS(_pattern)), matched(0), consumed(0) {
+        if (pattern.empty()) {
+            throw std::invalid_argument("The pattern must not be empty");
+        }
+    }
+
+    /*
+     * Function to search the next chunk of the text.
+     * Calls onMatch(offset) with the absolute starting offset of every match that ends in
+     * this chunk, including matches that began in earlier chunks.
+     */
+    template <typename OnMatch>
+    void feed(const char* data, size_t n, OnMatch onMatch) {
+        const char* p = pattern.data();
+        int m = pattern.size();
+        int j = matched;
+        for (size_t i = 0; i < n; i++) {
+            while (j > 0 && data[i] != p[j]) {
+                j = lps[j - 1];
+            }
+            if (data[i] == p[j]) {
+                j++;
+            }
+            if (j == m) {
+                onMatch(consumed + i + 1 - m);
+                j = lps[j - 1];
+            }
+        }
+        matched = j;
+        consumed += n;
+    }
+
+    // Function to start over with a new text
+    void reset() {
+        matched = 0;
+        consumed = 0;
+    }
+
+    // Function to get the number of text bytes fed so far
+    uint64_t position() const {
+        return consumed;
+    }
+
+    const std::string& getPattern() const {
+        return pattern;
+    }
+};
+
+// Size of the mapped window for regular files; a multiple of any page size
+const uint64_t STREAM_MAP_WINDOW = 1ULL << 30;
+
+// Size of each of the two read buffers for pipes and other streams
+const size_t STREAM_READ_BUFFER = 1 << 20;
+
+/*
+ * Function to search a regular file of `size` bytes by mapping it one window at a time.
+ * Each window is unmapped before the next is mapped, so the address space and page tables
+ * in use stay bounded for files of any size.
+ */
+template <typename Matcher, typename OnMatch>
+void searchMapped(int fd, uint64_t size, Matcher& matcher, OnMatch& onMatch) {
+    for (uint64_t offset = 0; offset < size; offset += STREAM_MAP_WINDOW) {
+        size_t length = std::min(STREAM_MAP_WINDOW, size - offset);
+        void* window = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, offset);
+        if (window == MAP_FAILED) {
+            throw std::runtime_error(std::string("mmap failed: ") + strerror(errno));
+        }
+        madvise(window, length, MADV_SEQUENTIAL);
+        try {
+            matcher.feed((const char*)window, length, onMatch);
+        } catch (...) {
+            munmap(window, length);
+            throw;
+        }
+        munmap(window, length);
+    }
+}
+
+/*
+ * Function to search a stream (pipe, terminal, socket) until end of input, double-buffered:
+ * a reader thread fills one buffer while the calling thread searches the other, so reading
+ * and matching overlap. Each buffer is handed over after one read(), so a live pipe is
+ * searched as soon as data arrives.
+ */
+template <typename Matcher, typename OnMatch>
+void searchStream(int fd, Matcher& matcher, OnMatch& onMatch) {
+    std::vector<char> buffers[2] = {std::vector<char>(STREAM_READ_BUFFER), std::vector<char>(STREAM_READ_BUFFER)};
+    ssize_t filled[2] = {-1, -1}; // Bytes in each buffer, -1 while it is free for the reader
+    bool finished = false, stopping = false;
+    int error = 0;
+    std::mutex lock;
+    std::condition_variable changed;
+
+    std::thread reader([&]() {
+        for (int b = 0;; b ^= 1) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                changed.wait(guard, [&]() { return filled[b] < 0 || stopping; });
+                if (stopping) return;
+            }
+            ssize_t got;
+            do {
+                got = read(fd, buffers[b].data(), buffers[b].size());
+            } while (got < 0 && errno == EINTR);
+            std::lock_guard<std::mutex> guard(lock);
+            if (got <= 0) {
+                error = got < 0 ? errno : 0;
+                finished = true;
+                changed.notify_all();
+                return;
+            }
+            filled[b] = got;
+            changed.notify_all();
+        }
+    });
+
+    try {
+        for (int b = 0;; b ^= 1) {
+            ssize_t size;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                changed.wait(guard, [&]() { return filled[b] >= 0 || finished; });
+                if (filled[b] < 0) break; // The reader finished before filling this buffer
+                size = filled[b];
+            }
+            matcher.feed(buffers[b].data(), size, onMatch);
+            std::lock_guard<std::mutex> guard(lock);
+            filled[b] = -1;
+            changed.notify_all();
+        }
+    } catch (...) {
+        // Stop the reader (after its current read) before the buffers go away
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+            changed.notify_all();
+        }
+        reader.join();
+        throw;
+    }
+    reader.join();
+    if (error != 0) {
+        throw std::runtime_error(std::string("read failed: ") + strerror(error));
+    }
+}
+
+/*
+ * Function to search a whole file, or standard input if the path is "-".
+ * Works with any matcher that has `feed(data, n, onMatch)` and `position()` like StreamingKMP;
+ * onMatch receives whatever the matcher reports. Returns the number of bytes searched.
+ */
+template <typename Matcher, typename OnMatch>
+uint64_t searchFile(const std::string& path, Matcher& matcher, OnMatch onMatch) {
+    int fd = (path == "-") ? STDIN_FILENO : open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path + ": " + strerror(errno));
+    }
+    uint64_t start = matcher.position();
+    try {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            searchMapped(fd, info.st_size, matcher, onMatch);
+        } else {
+            searchStream(fd, matcher, onMatch);
+        }
+    } catch (...) {
+        if (fd != STDIN_FILENO) close(fd);
+        throw;
+    }
+    if (fd != STDIN_FILENO) close(fd);
+    return matcher.position() - start;
+}
+
+} // namespace kmp
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef SUFFIX_TREE_H
+#define SUFFIX_TREE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * Suffix tree built with Ukkonen's algorithm.
+ * Contains:
+ *  - `Node`: A node and the edge leading to it.
+ *  - `SuffixTree`: Builds the tree of a string and prints its edge labels.
+ */
+namespace suffix_tree {
+
+/*
+ * Node structure for the Suffix Tree.
+ * Contains:
+ *  - `children`: A map of child nodes (keyed by characters).
+ *  - `start`: The starting index of the substring represented by this edge.
+ *  - `end`: The ending index of the substring (pointer for dynamic changes).
+ *  - `suffixLink`: A pointer to another node for fast traversal (used in Ukkonen's algorithm).
+ */
+struct Node {
+    std::map<char, Node*> children; // Children nodes
+    int start;                      // Start index of the edge
+    int* end;                       // End index of the edge (pointer for dynamic updates)
+    Node* suffixLink;               // Suffix link for Ukkonen's algorithm
+
+    // Constructor to initialize a new node
+    Node(int start, int* end) {
+        this->start = start;
+        this->end = end;
+        this->suffixLink = nullptr;
+    }
+
+    // Get the length of the edge
+    int edgeLength() const {
+        return *end - start + 1;
+    }
+};
+
+/*
+ * Class to represent the Suffix Tree.
+ * Contains:
+ *  - `root`: Pointer to the root node of the tree.
+ *  - `text`: The input string for which the suffix tree is built.
+ * All leaves share `leafEnd`; the root and every internal node own their `end`, which the
+ * destructor frees together with the nodes.
+ */
+class SuffixTree {
+private:
+    std::string text;
+    Node* root;        // Root of the tree
+    Node* activeNode;  // Active node during construction
+    int activeEdge;    // Index of the active edge in the text
+    int activeLength;  // Length of the active edge
+    int remainingSuffixCount; // Suffixes yet to be added
+    int* leafEnd;      // Pointer to the current end of all leaves
+    int size;          // Length of the input string
+
+    // Function to build the suffix tree
+    void buildSuffixTree();
+
+    // Helper function for traversal
+    void traverseHelper(Node* node, int height, std::string& result) const;
+
+public:
+    // Constructor
+    explicit SuffixTree(const std::string& input);
+
+    // Destructor: frees every node (iteratively, since the tree can be as deep as the text is long)
+    ~SuffixTree();
+
+    SuffixTree(const SuffixTree&) = delete;
+    SuffixTree& operator=(const SuffixTree&) = delete;
+
+    // Function to count the nodes, root and leaves included
+    int countNodes() const;
+
+    // Function to print the suffix tree to any stream with operator<< for strings
+    template <typename Out>
+    void printSuffixTree(Out& out) const {
+        std::string result;
+        traverseHelper(root, 0, result);
+        out << "Suffix Tree:\n" << result << "\n";
+    }
+};
+
+// Constructor to initialize the suffix tree
+inline SuffixTree::SuffixTree(const std::string& input) {
+    text = input + "$"; // Append a unique character to the string
+    size = text.size();
+    root = new Node(-1, new int(-1)); // Root has no edge
+    leafEnd = new int(-1);           // Initialize leaf end pointer
+    buildSuffixTree();               // Build the tree
+}
+
+inline SuffixTree::~SuffixTree() {
+    std::vector<Node*> stack = {root};
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        for (auto& child : node->children) {
+            stack.push_back(child.second);
+        }
+        if (node->end != leafEnd) {
+            delete node->end;
+        }
+        delete node;
+    }
+    delete leafEnd;
+}
+
+// Function to build the suffix tree using Ukkonen's algorithm
+inline void SuffixTree::buildSuffixTree() {
+    activeNode = root; // Start at the root
+    activeEdge = -1;
+    activeLength = 0;
+    remainingSuffixCount = 0;
+
+    for (int i = 0; i < size; i++) {
+        (*leafEnd)++;
+        remainingSuffixCount++;
+
+        Node* lastCreatedInternalNode = nullptr;
+
+        while (remainingSuffixCount > 0) {
+            if (activeLength == 0) activeEdge = i;
+
+            if (activeNode->children.find(text[activeEdge]) == activeNode->children.end()) {
+                activeNode->children[text[activeEdge]] = new Node(i, leafEnd);
+
+                if (lastCreatedInternalNode != nullptr) {
+                    lastCreatedInternalNode->suffixLink = activeNode;
+                    lastCreatedInternalNode = nullptr;
+                }
+            } else {
+                Node* nextNode = activeNode->children[text[activeEdge]];
+
+                if (activeLength >= nextNode->edgeLength()) {
+                    activeEdge += nextNode->edgeLength();
+                    activeLength -= nextNode->edgeLength();
+                    activeNode = nextNode;
+                    continue;
+                }
+
+                if (text[nextNode->start + activeLength] == text[i]) {
+                    activeLength++;
+                    if (lastCreatedInternalNode != nullptr) {
+                        lastCreatedInternalNode->suffixLink = activeNode;
+                        lastCreatedInternalNode = nullptr;
+                    }
+                    break;
+                }
+
+                int* splitEnd = new int(nextNode->start + activeLength - 1);
+                Node* split = new Node(nextNode->start, splitEnd);
+                activeNode->children[text[activeEdge]] = split;
+
+                split->children[text[i]] = new Node(i, leafEnd);
+                nextNode->start += activeLength;
+                split->children[text[nextNode->start]] = nextNode;
+
+                if (lastCreatedInternalNode != nullptr) {
+                    lastCreatedInternalNode->suffixLink = split;
+                }
+
+                lastCreatedInternalNode = split;
+            }
+
+            remainingSuffixCount--;
+
+            if (activeNode == root && activeLength > 0) {
+                activeLength--;
+                activeEdge = i - remainingSuffixCount + 1;
+            } else if (activeNode != root) {
+                activeNode = activeNode->suffixLink;
+            }
+        }
+    }
+}
+
+// Function to count the nodes (iteratively, like the destructor)
+inline int SuffixTree::countNodes() const {
+    int count = 0;
+    std::vector<const Node*> stack = {root};
+    while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+        count++;
+        for (const auto& child : node->children) {
+            stack.push_back(child.second);
+        }
+    }
+    return count;
+}
+
+// Helper function to traverse and collect substrings
+inline void SuffixTree::traverseHelper(Node* node, int height, std::string& result) const {
+    if (node == nullptr) return;
+
+    if (node->start != -1) {
+        result += text.substr(node->start, node->edgeLength());
+    }
+
+    for (auto& child : node->children) {
+        traverseHelper(child.second, height + child.second->edgeLength(), result);
+        result += "\n";
+    }
+}
+
+} // namespace suffix_tree
+
+#endif